@@ -1,6 +1,6 @@
 #pragma once
 
-#include "traits.h" // is_resource_v, resource_traits
+#include "traits.h" // is_resource_v, resource_traits, allocation_result
 
 #include <cstddef> // size_t
 #include <memory> // pointer_traits
@@ -52,6 +52,25 @@ namespace kp11
         }
         return static_cast<pointer>(ptr);
       }
+      /// Like `std::allocator::allocate_at_least`, calls `resource_traits::allocate_at_least` with
+      /// `sizeof(T) * n` as size and `align(T)` as alignment.
+      ///
+      /// @param n Minimum number of `sizeof(T)` blocks to allocate.
+      ///
+      /// @returns Pointer to a memory block aligned to `alignof(T)` and the number of `T` that fit
+      /// in it, which is at least `n`. The number can be passed to `deallocate`.
+      ///
+      /// @throws (failure) std::bad_alloc
+      allocation_result<pointer, size_type> allocate_at_least(size_type n)
+      {
+        auto r = resource_traits<R>::allocate_at_least(
+          resource(), static_cast<size_type>(sizeof(T) * n), alignof(T));
+        if (!r.ptr)
+        {
+          throw std::bad_alloc();
+        }
+        return {static_cast<pointer>(r.ptr), static_cast<size_type>(r.count / sizeof(T))};
+      }
       /// Calls `Resource::deallocate` with `ptr`, `sizeof(T) * n` as size and `align(T)` as
       /// alignment.
       ///
@@ -103,4 +103,14 @@ TEST_CASE("local rebinding", "[rebinding][local]")
   REQUIRE(l.size() == 3);
   REQUIRE(l.front() == 5);
   REQUIRE(l.back() == 15);
+}
+TEST_CASE("allocate_at_least", "[basic][local]")
+{
+  free_block<256, alignof(std::max_align_t), 2, stack<4>, heap> m; // 64 byte blocks
+  allocator<int, decltype(m) *> x(&m);
+  auto a = x.allocate_at_least(3);
+  REQUIRE(a.ptr != nullptr);
+  REQUIRE(a.count == 64 / sizeof(int));
+  x.deallocate(a.ptr, a.count);
+  REQUIRE(m.bytes_in_use() == 0);
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "bitset.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef> // size_t
+
+using namespace kp11;
+
+// The markers are filled so that the only free indexes are at the very end, which is the worst case
+// for a first fit search.
+
+template<std::size_t N>
+static void bitset_allocate_one(benchmark::State & state)
+{
+  bitset<N> m;
+  m.allocate(N);
+  for (auto _ : state)
+  {
+    m.deallocate(N - 1, 1);
+    benchmark::DoNotOptimize(m.allocate(1));
+  }
+}
+BENCHMARK_TEMPLATE(bitset_allocate_one, 64);
+BENCHMARK_TEMPLATE(bitset_allocate_one, 512);
+BENCHMARK_TEMPLATE(bitset_allocate_one, 4096);
+
+template<std::size_t N>
+static void bitset_allocate_many(benchmark::State & state)
+{
+  bitset<N> m;
+  m.allocate(N);
+  for (auto _ : state)
+  {
+    m.deallocate(N - 8, 8);
+    benchmark::DoNotOptimize(m.allocate(8));
+  }
+}
+BENCHMARK_TEMPLATE(bitset_allocate_many, 64);
+BENCHMARK_TEMPLATE(bitset_allocate_many, 512);
+BENCHMARK_TEMPLATE(bitset_allocate_many, 4096);
+
+// Every other index is allocated so runs of `n > 1` never fit until the end.
+template<std::size_t N>
+static void bitset_allocate_many_fragmented(benchmark::State & state)
+{
+  bitset<N> m;
+  m.allocate(N);
+  for (std::size_t i = 0; i < N - 8; i += 2)
+  {
+    m.deallocate(i, 1);
+  }
+  for (auto _ : state)
+  {
+    m.deallocate(N - 8, 8);
+    benchmark::DoNotOptimize(m.allocate(8));
+  }
+}
+BENCHMARK_TEMPLATE(bitset_allocate_many_fragmented, 64);
+BENCHMARK_TEMPLATE(bitset_allocate_many_fragmented, 512);
+BENCHMARK_TEMPLATE(bitset_allocate_many_fragmented, 4096);
\ No newline at end of file
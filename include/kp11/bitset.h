@@ -1,14 +1,17 @@
 #pragma once
 
-#include <bitset> // bitset
+#include "detail/bit.h" // word, word_bits, countr_zero, countl_zero, popcount, mask, find_runs, longest_zero_run
+
+#include <array> // array
 #include <cassert> // assert
 #include <cstddef> // size_t
 
 namespace kp11
 {
-  /// @brief First fit. Iterates through individual bits in a bitset.
+  /// @brief First fit. Iterates through a bitset a word at a time.
   ///
-  /// Indexes stored as a bitset, where each bit corresponds to an index.
+  /// Indexes stored as a bitset, where each bit corresponds to an index. The bits are packed into
+  /// 64-bit words so that a whole word of indexes can be skipped or searched at once.
   ///
   /// @tparam N Total number of indexes
   template<std::size_t N>
@@ -18,11 +21,35 @@ namespace kp11
     /// Size type.
     using size_type = std::size_t;
 
+  private: // typedefs
+    using word = detail::word;
+
+  private: // constants
+    static constexpr size_type word_bits = detail::word_bits;
+    static constexpr size_type num_words = N / word_bits + (N % word_bits != 0);
+    /// Number of bits in the last word that are past `N`.
+    static constexpr size_type num_padding = num_words * word_bits - N;
+
+  public: // constructors
+    bitset() noexcept
+    {
+      // Bits past `N` are permanently allocated so that searches never have to check for them.
+      if constexpr (num_padding != 0)
+      {
+        words[num_words - 1] = ~word(0) << (word_bits - num_padding);
+      }
+    }
+
   public: // capacity
     /// @returns Number of allocated indexes.
     size_type count() const noexcept
     {
-      return bits.count();
+      size_type n = 0;
+      for (auto w : words)
+      {
+        n += detail::popcount(w);
+      }
+      return n - num_padding;
     }
     /// @returns Total number of indexes (`N`).
     static constexpr size_type size() noexcept
@@ -34,11 +61,18 @@ namespace kp11
     {
       return size();
     }
+    /// @returns Largest `n` that `allocate(n)` would currently succeed with, which is the length of
+    /// the longest run of unallocated indexes.
+    /// * Complexity `O(N / 64)`
+    size_type largest_free_run() const noexcept
+    {
+      return detail::longest_zero_run(words.begin(), words.end());
+    }
 
   public: // modifiers
-    /// Forward iterate through the bitset to find an index suitable for `n`.
+    /// Forward iterate through the bitset a word at a time to find an index suitable for `n`.
     /// The algorithms for `n==1` and `n!=1` are different.
-    /// * Complexity `O(n)`
+    /// * Complexity `O(N / 64)`
     ///
     /// @param n Number of indexes to allocate.
     ///
@@ -57,8 +91,45 @@ namespace kp11
       assert(n <= max_size());
       return n == 1 ? allocate_one() : allocate_many(n);
     }
-    /// Forward iterate through the bitset from `i` to `i + n` and deallocate them.
-    /// * Complexity `O(n)`
+    /// Allocate `count` runs of `n` indexes. Runs of `1` are taken from a single forward scan,
+    /// where every unallocated bit of a word is claimed before moving onto the next word.
+    /// * Complexity `O(N / 64 + count)` for `n == 1`, `O(count * N / 64)` for `n > 1`.
+    ///
+    /// @param n Number of indexes in each allocation.
+    /// @param count Number of allocations.
+    /// @param out Written with the index of each allocation.
+    ///
+    /// @returns Number of allocations written to the front of `out`.
+    ///
+    /// @pre `n > 0`
+    /// @pre `n <= max_size()`
+    size_type allocate_bulk(size_type n, size_type count, size_type * out) noexcept
+    {
+      assert(n > 0);
+      assert(n <= max_size());
+      size_type i = 0;
+      if (n != 1)
+      {
+        for (; i != count && (out[i] = allocate_many(n)) != size(); ++i)
+        {
+        }
+        return i;
+      }
+      for (size_type k = 0; k != num_words && i != count; ++k)
+      {
+        auto w = words[k];
+        for (; w != ~word(0) && i != count; ++i)
+        {
+          auto const b = detail::countr_zero(~w);
+          w |= word(1) << b;
+          out[i] = k * word_bits + b;
+        }
+        words[k] = w;
+      }
+      return i;
+    }
+    /// Forward iterate through the bitset from `i` to `i + n` a word at a time and deallocate them.
+    /// * Complexity `O(n / 64)`
     ///
     /// @param i Return value of a call to `allocate` that isn't `size()`.
     /// @param n Corresponding parameter in the call to `allocate`.
@@ -70,53 +141,90 @@ namespace kp11
       assert(n <= size());
       assert(i < size());
       assert(i + n <= size());
-      for (auto first = i, last = i + n; first < last; ++first)
-      {
-        bits.reset(first);
-      }
+      assign(i, n, false);
     }
 
   private: // helper functions
     /// Allocating one is a much simpler algorithm because we don't have to count adjacent bits.
+    /// The first word with an unallocated bit is found and then the lowest unallocated bit is
+    /// found by counting trailing ones.
     size_type allocate_one() noexcept
     {
-      size_type first = 0;
-      for (; first != size() && bits[first]; ++first)
-      {
-      }
-      if (first != size())
+      for (size_type k = 0; k != num_words; ++k)
       {
-        bits.set(first);
-        return first;
+        if (auto const w = words[k]; w != ~word(0))
+        {
+          auto const b = detail::countr_zero(~w);
+          words[k] = w | (word(1) << b);
+          return k * word_bits + b;
+        }
       }
       return size();
     }
+    /// Runs are either carried over the boundary between words or are contained inside of a
+    /// single word.
     size_type allocate_many(size_type n) noexcept
     {
       assert(n > 1);
-      for (size_type first = 0, count = 0; first != size(); ++first)
+      // Number of unallocated bits at the end of the previous words.
+      size_type run = 0;
+      for (size_type k = 0; k != num_words; ++k)
       {
-        if (bits[first])
+        auto const w = words[k];
+        // The carried run continues up to the first allocated bit in this word.
+        if (run + detail::countr_zero(w) >= n)
+        {
+          return claim(k * word_bits - run, n);
+        }
+        if (w == 0)
         {
-          count = 0;
+          run += word_bits;
+          continue;
         }
-        else if (++count == n)
+        if (n <= word_bits)
         {
-          // have to increment first before we can decrement the count since we're off by 1
-          ++first;
-          for (auto count = n; count; --count)
+          if (auto const starts = detail::find_runs(~w, n))
           {
-            bits.set(--first);
+            return claim(k * word_bits + detail::countr_zero(starts), n);
           }
-          return first;
         }
+        run = detail::countl_zero(w);
       }
       return size();
     }
+    /// Allocate [`i`, `i + n`).
+    ///
+    /// @returns `i`
+    size_type claim(size_type i, size_type n) noexcept
+    {
+      assign(i, n, true);
+      return i;
+    }
+    /// Set or reset the bits [`i`, `i + n`) one word at a time.
+    void assign(size_type i, size_type n, bool value) noexcept
+    {
+      for (auto last = i + n; i != last;)
+      {
+        auto const k = i / word_bits;
+        auto const b = i % word_bits;
+        auto const m = last - i < word_bits - b ? last - i : word_bits - b;
+        auto const bits = detail::mask(b, m);
+        if (value)
+        {
+          assert((words[k] & bits) == 0);
+          words[k] |= bits;
+        }
+        else
+        {
+          assert((words[k] & bits) == bits);
+          words[k] &= ~bits;
+        }
+        i += m;
+      }
+    }
 
   private: // variables
-    /// `true` if allocated, `false` if not allocated, this is to be consistent with
-    /// `bitset::set`.
-    std::bitset<N> bits;
+    /// `1` if allocated, `0` if not allocated. Index `i` is bit `i % 64` of word `i / 64`.
+    std::array<word, num_words> words = {};
   };
 }
\ No newline at end of file
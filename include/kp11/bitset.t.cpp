@@ -4,6 +4,8 @@
 
 #include <catch.hpp>
 
+#include <cstddef> // size_t
+
 using namespace kp11;
 
 TEST_CASE("size", "[size]")
@@ -77,6 +79,105 @@ TEST_CASE("deallocate", "[deallocate]")
     REQUIRE(b == a);
   }
 }
+TEST_CASE("multiple words", "[words]")
+{
+  bitset<200> m;
+  SECTION("allocate 1 crosses into the next word")
+  {
+    REQUIRE(m.allocate(64) == 0);
+    REQUIRE(m.allocate(1) == 64);
+    REQUIRE(m.count() == 65);
+  }
+  SECTION("allocate many spanning words")
+  {
+    REQUIRE(m.allocate(60) == 0);
+    auto a = m.allocate(10);
+    REQUIRE(a == 60);
+    REQUIRE(m.count() == 70);
+    auto b = m.allocate(130);
+    REQUIRE(b == 70);
+    REQUIRE(m.count() == 200);
+    REQUIRE(m.allocate(1) == m.size());
+    m.deallocate(a, 10);
+    REQUIRE(m.allocate(11) == m.size());
+    REQUIRE(m.allocate(10) == a);
+  }
+  SECTION("first fit inside of a word")
+  {
+    m.allocate(200);
+    m.deallocate(3, 2);
+    m.deallocate(70, 5);
+    m.deallocate(130, 3);
+    REQUIRE(m.count() == 190);
+    REQUIRE(m.allocate(3) == 70);
+    REQUIRE(m.allocate(3) == 130);
+    REQUIRE(m.allocate(2) == 3);
+    REQUIRE(m.allocate(2) == 73);
+    REQUIRE(m.count() == 200);
+  }
+  SECTION("padding is never allocated")
+  {
+    m.allocate(192);
+    REQUIRE(m.allocate(9) == m.size());
+    REQUIRE(m.allocate(8) == 192);
+    REQUIRE(m.allocate(1) == m.size());
+  }
+}
+TEST_CASE("allocate_bulk", "[allocate_bulk]")
+{
+  bitset<100> m;
+  std::size_t out[100] = {};
+  SECTION("1")
+  {
+    m.allocate(3);
+    REQUIRE(m.allocate_bulk(1, 70, out) == 70);
+    REQUIRE(m.count() == 73);
+    for (std::size_t i = 0; i != 70; ++i)
+    {
+      REQUIRE(out[i] == i + 3);
+    }
+    REQUIRE(m.allocate_bulk(1, 100, out) == 27);
+    REQUIRE(m.count() == 100);
+    REQUIRE(m.allocate_bulk(1, 1, out) == 0);
+  }
+  SECTION("many")
+  {
+    REQUIRE(m.allocate_bulk(30, 4, out) == 3);
+    REQUIRE(out[0] == 0);
+    REQUIRE(out[1] == 30);
+    REQUIRE(out[2] == 60);
+    REQUIRE(m.count() == 90);
+  }
+  SECTION("fills holes")
+  {
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+      m.allocate(1);
+    }
+    m.deallocate(5, 1);
+    m.deallocate(70, 1);
+    REQUIRE(m.allocate_bulk(1, 3, out) == 2);
+    REQUIRE(out[0] == 5);
+    REQUIRE(out[1] == 70);
+  }
+}
+TEST_CASE("largest_free_run", "[largest_free_run]")
+{
+  bitset<130> m;
+  REQUIRE(m.largest_free_run() == 130);
+  auto a = m.allocate(10);
+  auto b = m.allocate(60);
+  m.allocate(1);
+  REQUIRE(m.largest_free_run() == 59);
+  m.deallocate(b, 60);
+  REQUIRE(m.largest_free_run() == 60);
+  m.deallocate(a, 10);
+  REQUIRE(m.largest_free_run() == 70);
+  m.allocate(70);
+  REQUIRE(m.largest_free_run() == 59);
+  m.allocate(59);
+  REQUIRE(m.largest_free_run() == 0);
+}
 TEST_CASE("traits", "[traits]")
 {
   REQUIRE(is_marker_v<bitset<10>> == true);
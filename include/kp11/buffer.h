@@ -1,5 +1,7 @@
 #pragma once
 
+#include "traits.h" // allocation_result
+
 #include <cassert> // assert
 #include <cstddef> // size_t
 #include <functional> // less, less_equal
@@ -70,6 +72,25 @@ namespace kp11
       }
       return nullptr;
     }
+    /// Same as `allocate` but also returns the usable size, which is the whole buffer.
+    /// * Complexity `O(1)`
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @returns (success) Pointer to our buffer and its size.
+    /// @returns (failure) `nullptr` and `0`.
+    ///
+    /// @pre `alignment (from ctor) % alignment == 0`
+    allocation_result<pointer, size_type> allocate_at_least(
+      size_type size, size_type alignment) noexcept
+    {
+      if (auto ptr = allocate(size, alignment))
+      {
+        return {ptr, this->size};
+      }
+      return {nullptr, 0};
+    }
     /// If `ptr` points to the our buffer then we can allocate our buffer again.
     /// * Complexity `O(1)`
     ///
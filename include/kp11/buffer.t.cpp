@@ -22,6 +22,16 @@ TEST_CASE("allocate", "[allocate]")
   auto b = m.allocate(32, 4);
   REQUIRE(b == nullptr);
 }
+TEST_CASE("allocate_at_least", "[allocate]")
+{
+  alignas(4) char buf[128];
+  buffer m = {buf, 128, 4};
+  auto a = m.allocate_at_least(32, 4);
+  REQUIRE(a.ptr == buf);
+  REQUIRE(a.count == 128);
+  REQUIRE(m.allocate_at_least(32, 4).ptr == nullptr);
+  REQUIRE(m.deallocate(a.ptr, a.count, 4) == true);
+}
 TEST_CASE("deallocate", "[deallocate]")
 {
   alignas(4) char buf[128];
@@ -0,0 +1,65 @@
+#include "concurrent_pool.h"
+
+#include "pool.h" // pool
+
+#include <benchmark/benchmark.h>
+
+#include <mutex> // mutex, lock_guard
+
+using namespace kp11;
+
+namespace
+{
+  /// @private
+  template<std::size_t N>
+  class locked_pool
+  {
+  public:
+    using size_type = typename pool<N>::size_type;
+    static constexpr size_type size() noexcept
+    {
+      return pool<N>::size();
+    }
+    size_type allocate(size_type n) noexcept
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return m.allocate(n);
+    }
+    void deallocate(size_type i, size_type n) noexcept
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      m.deallocate(i, n);
+    }
+
+  private:
+    std::mutex mutex;
+    pool<N> m;
+  };
+}
+
+// Every thread allocates and deallocates a few indexes from one shared marker.
+template<typename Marker>
+static void concurrent_pool_contention(benchmark::State & state)
+{
+  static Marker m;
+  typename Marker::size_type held[4];
+  for (auto _ : state)
+  {
+    for (auto & i : held)
+    {
+      i = m.allocate(1);
+    }
+    for (auto i : held)
+    {
+      if (i != m.size())
+      {
+        m.deallocate(i, 1);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(held));
+}
+BENCHMARK_TEMPLATE(concurrent_pool_contention, concurrent_pool<4096>)
+  ->ThreadRange(1, 16)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(concurrent_pool_contention, locked_pool<4096>)->ThreadRange(1, 16)->UseRealTime();
\ No newline at end of file
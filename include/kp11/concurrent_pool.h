@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array> // array
+#include <atomic> // atomic, memory_order_relaxed, memory_order_acquire, memory_order_release
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <cstdint> // uint_least8_t, uint_least16_t, uint_least32_t, uint64_t, UINT_LEAST8_MAX, UINT_LEAST16_MAX, UINT32_MAX
+#include <type_traits> // conditional_t
+
+namespace kp11
+{
+  /// @brief Lock free LIFO. Only supports `allocate` and `deallocate` with `n == 1`.
+  ///
+  /// Same singly linked list of indexes as `pool` except that `allocate` and `deallocate` may be
+  /// called concurrently from any number of threads. The head index is packed into a 64-bit word
+  /// together with a tag that is incremented by every change to the head, so that a
+  /// compare-and-swap fails if the head was popped and pushed back in between (the ABA problem).
+  ///
+  /// @tparam N Total number of indexes. Must fit into 32 bits.
+  template<std::size_t N>
+  class concurrent_pool
+  {
+    static_assert(N < UINT32_MAX);
+
+  public: // typedefs
+    /// Size type is the smallest type possible to reduce our array size.
+    using size_type = std::conditional_t<N <= UINT_LEAST8_MAX,
+      uint_least8_t,
+      std::conditional_t<N <= UINT_LEAST16_MAX, uint_least16_t, uint_least32_t>>;
+
+  private: // typedefs
+    /// Index in the low 32 bits and tag in the high 32 bits.
+    using tagged = std::uint64_t;
+
+    // Otherwise the atomics fall back to a lock and we aren't lock free.
+    static_assert(std::atomic<tagged>::is_always_lock_free);
+    static_assert(std::atomic<size_type>::is_always_lock_free);
+
+  public: // constructors
+    concurrent_pool() noexcept
+    {
+      for (size_type i = 0, last = size(); i < last; ++i)
+      {
+        next[i].store(static_cast<size_type>(i + 1), std::memory_order_relaxed);
+      }
+    }
+
+  public: // capacity
+    /// @returns Number of allocated indexes. Only a snapshot if other threads are modifying us.
+    size_type count() const noexcept
+    {
+      return num_occupied.load(std::memory_order_relaxed);
+    }
+    /// @returns Total number of indexes (`N`).
+    static constexpr size_type size() noexcept
+    {
+      return static_cast<size_type>(N);
+    }
+    /// @returns The maximum allocation size supported. This is always `1`.
+    static constexpr size_type max_size() noexcept
+    {
+      return static_cast<size_type>(1);
+    }
+
+  public: // modifiers
+    /// Compare-and-swap the head with the next node until it succeeds or the list is empty.
+    /// Returns the index of the previous head node.
+    /// * Complexity `O(1)` without contention.
+    ///
+    /// @param n Number of indexes to allocate.
+    ///
+    /// @returns (success) Index of the start of the `n` indexes to allocate.
+    /// @returns (failure) `size()`
+    ///
+    /// @pre `n == 1`
+    /// @pre `n <= max_size()`
+    ///
+    /// @post `(return value)` will not returned again from any subsequent call to `allocate`
+    /// unless `deallocate` has been called on it.
+    /// @post `count() == (previous) count() + n`
+    size_type allocate(size_type n) noexcept
+    {
+      assert(n == 1);
+      assert(n <= max_size());
+      auto h = head.load(std::memory_order_acquire);
+      while (index_of(h) != size())
+      {
+        // May read a stale value if another thread pops `h` first, in which case the tag has
+        // changed and the compare-and-swap fails.
+        auto const n2 = next[index_of(h)].load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(
+              h, make_tagged(n2, h), std::memory_order_acquire, std::memory_order_acquire))
+        {
+          num_occupied.fetch_add(1, std::memory_order_relaxed);
+          return index_of(h);
+        }
+      }
+      return size();
+    }
+    /// Point the node at `i` to the head node and compare-and-swap it in as the new head node
+    /// until it succeeds.
+    /// * Complexity `O(1)` without contention.
+    ///
+    /// @param i Returned by a call to `allocate`.
+    /// @param n Corresponding parameter in the call to `allocate`.
+    ///
+    /// @pre `n == 1`
+    ///
+    /// @post `i` may be returned by a call to `allocate`.
+    /// @post `count() == (previous) count() - n`
+    void deallocate(size_type i, size_type n) noexcept
+    {
+      assert(n == 1);
+      assert(i < size());
+      num_occupied.fetch_sub(1, std::memory_order_relaxed);
+      auto h = head.load(std::memory_order_relaxed);
+      do
+      {
+        next[i].store(index_of(h), std::memory_order_relaxed);
+      } while (!head.compare_exchange_weak(
+        h, make_tagged(i, h), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+  private: // helpers
+    static size_type index_of(tagged h) noexcept
+    {
+      return static_cast<size_type>(h & 0xFFFFFFFF);
+    }
+    /// @returns `i` with the tag of `h` incremented.
+    static tagged make_tagged(size_type i, tagged h) noexcept
+    {
+      return ((h >> 32) + 1) << 32 | i;
+    }
+
+  private: // variables
+    std::atomic<size_type> num_occupied = 0;
+    /// First free index or `N`, tagged.
+    std::atomic<tagged> head = 0;
+    /// Holds the index of the next free index.
+    std::array<std::atomic<size_type>, N> next;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "concurrent_pool.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "traits.h" // is_marker_v
+
+#include <catch.hpp>
+
+#include <array> // array
+#include <thread> // thread
+#include <vector> // vector
+
+using namespace kp11;
+
+TEST_CASE("size", "[size]")
+{
+  SECTION("1")
+  {
+    concurrent_pool<10> m;
+    REQUIRE(m.size() == 10);
+    REQUIRE(m.max_size() == 1);
+    REQUIRE(m.count() == 0);
+  }
+  SECTION("2")
+  {
+    concurrent_pool<101581> m;
+    REQUIRE(m.size() == 101581);
+    REQUIRE(m.max_size() == 1);
+    REQUIRE(m.count() == 0);
+  }
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  concurrent_pool<10> m;
+  SECTION("success")
+  {
+    auto a = m.allocate(1);
+    REQUIRE(a == 0);
+    REQUIRE(m.count() == 1);
+    SECTION("post condition")
+    {
+      auto b = m.allocate(1);
+      REQUIRE(b == 1);
+      REQUIRE(b != a);
+      REQUIRE(m.count() == 2);
+    }
+  }
+  SECTION("failure")
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      m.allocate(1);
+    }
+    REQUIRE(m.allocate(1) == m.size());
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  concurrent_pool<10> m;
+  SECTION("recovers indexes")
+  {
+    auto a = m.allocate(1);
+    m.deallocate(a, 1);
+    REQUIRE(m.count() == 0);
+    auto b = m.allocate(1);
+    REQUIRE(b == a);
+  }
+}
+TEST_CASE("threads", "[threads]")
+{
+  // Every thread repeatedly takes a few indexes, marks them as its own and gives them back. An
+  // index handed out twice shows up as a wrong owner (or as a data race under a thread sanitizer).
+  constexpr int num_threads = 8;
+  constexpr int num_iterations = 10000;
+  concurrent_pool<16> m;
+  std::array<int, 16> owners = {};
+  std::array<int, num_threads> failures = {};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t] {
+      for (int k = 0; k < num_iterations; ++k)
+      {
+        std::array<unsigned, 2> held;
+        for (auto & i : held)
+        {
+          while ((i = m.allocate(1)) == m.size())
+          {
+            std::this_thread::yield();
+          }
+          owners[i] = t + 1;
+        }
+        for (auto i : held)
+        {
+          failures[t] += owners[i] != t + 1;
+          owners[i] = 0;
+          m.deallocate(static_cast<concurrent_pool<16>::size_type>(i), 1);
+        }
+      }
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  for (auto f : failures)
+  {
+    REQUIRE(f == 0);
+  }
+  REQUIRE(m.count() == 0);
+  for (int i = 0; i < 16; ++i)
+  {
+    REQUIRE(m.allocate(1) != m.size());
+  }
+  REQUIRE(m.allocate(1) == m.size());
+}
+TEST_CASE("free_block", "[free_block]")
+{
+  free_block<1024, 16, 1, concurrent_pool<64>, heap> r;
+  auto a = r.allocate(16, 16);
+  REQUIRE(a != nullptr);
+  REQUIRE(r[a] == a);
+  REQUIRE(r.deallocate(a, 16, 16));
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_marker_v<concurrent_pool<10>> == true);
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#if defined(_MSC_VER)
+#  include <intrin.h> // _BitScanForward64, _BitScanReverse64, __popcnt64
+#endif
+
+namespace kp11::detail
+{
+  /// Word type used for word parallel bit manipulation.
+  using word = std::uint64_t;
+  /// Number of bits in a `word`.
+  inline constexpr std::size_t word_bits = 64;
+
+  /// @returns Number of consecutive `0` bits starting from the least significant bit.
+  inline std::size_t countr_zero(word x) noexcept
+  {
+    if (x == 0)
+    {
+      return word_bits;
+    }
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return i;
+#else
+    return static_cast<std::size_t>(__builtin_ctzll(x));
+#endif
+  }
+  /// @returns Number of consecutive `0` bits starting from the most significant bit.
+  inline std::size_t countl_zero(word x) noexcept
+  {
+    if (x == 0)
+    {
+      return word_bits;
+    }
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanReverse64(&i, x);
+    return word_bits - 1 - i;
+#else
+    return static_cast<std::size_t>(__builtin_clzll(x));
+#endif
+  }
+  /// @returns Number of `1` bits.
+  inline std::size_t popcount(word x) noexcept
+  {
+#if defined(_MSC_VER)
+    return static_cast<std::size_t>(__popcnt64(x));
+#else
+    return static_cast<std::size_t>(__builtin_popcountll(x));
+#endif
+  }
+  /// @returns Word with the bits [`first`, `first + n`) set.
+  ///
+  /// @pre `first + n <= word_bits`
+  inline word mask(std::size_t first, std::size_t n) noexcept
+  {
+    assert(first + n <= word_bits);
+    return n == word_bits ? ~word(0) : ((word(1) << n) - 1) << first;
+  }
+  /// Find the starting bits of every run of `n` consecutive `1` bits that fit inside of `x`.
+  /// Each step doubles the length of the runs that are detected so it only takes `O(log n)` shifts.
+  ///
+  /// @returns Word where bit `i` is set if bits [`i`, `i + n`) of `x` are all set.
+  ///
+  /// @pre `n > 0`
+  /// @pre `n <= word_bits`
+  inline word find_runs(word x, std::size_t n) noexcept
+  {
+    assert(n > 0);
+    assert(n <= word_bits);
+    for (std::size_t len = 1; len < n && x;)
+    {
+      auto const shift = len < n - len ? len : n - len;
+      x &= x >> shift;
+      len += shift;
+    }
+    return x;
+  }
+  /// Each word is either part of a run that carries over the boundary between words or has its
+  /// runs found by skipping over alternating runs of `1` and `0` bits.
+  ///
+  /// @returns Length of the longest run of `0` bits in [`first`, `last`), where bit `i` is bit
+  /// `i % 64` of word `i / 64`.
+  template<typename It>
+  std::size_t longest_zero_run(It first, It last) noexcept
+  {
+    std::size_t longest = 0;
+    // Number of `0` bits at the end of the previous words.
+    std::size_t run = 0;
+    for (; first != last; ++first)
+    {
+      word x = *first;
+      if (x == 0)
+      {
+        run += word_bits;
+        continue;
+      }
+      auto b = countr_zero(x);
+      run += b;
+      longest = run > longest ? run : longest;
+      x >>= b;
+      // `x` starts with a `1` bit here.
+      while (true)
+      {
+        auto const ones = countr_zero(~x);
+        b += ones;
+        if (b == word_bits)
+        {
+          run = 0;
+          break;
+        }
+        x >>= ones;
+        if (x == 0)
+        {
+          run = word_bits - b;
+          break;
+        }
+        auto const zeros = countr_zero(x);
+        longest = zeros > longest ? zeros : longest;
+        b += zeros;
+        x >>= zeros;
+      }
+    }
+    return run > longest ? run : longest;
+  }
+}
\ No newline at end of file
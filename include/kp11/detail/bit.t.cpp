@@ -0,0 +1,55 @@
+#include "bit.h"
+
+#include <catch.hpp>
+
+#include <initializer_list> // initializer_list
+
+using namespace kp11::detail;
+
+TEST_CASE("count", "[count]")
+{
+  REQUIRE(countr_zero(0) == 64);
+  REQUIRE(countr_zero(1) == 0);
+  REQUIRE(countr_zero(0b1000) == 3);
+  REQUIRE(countl_zero(0) == 64);
+  REQUIRE(countl_zero(1) == 63);
+  REQUIRE(countl_zero(~word(0)) == 0);
+  REQUIRE(popcount(0) == 0);
+  REQUIRE(popcount(0b1011) == 3);
+  REQUIRE(popcount(~word(0)) == 64);
+}
+TEST_CASE("mask", "[mask]")
+{
+  REQUIRE(mask(0, 0) == 0);
+  REQUIRE(mask(0, 1) == 1);
+  REQUIRE(mask(2, 3) == 0b11100);
+  REQUIRE(mask(0, 64) == ~word(0));
+  REQUIRE(mask(63, 1) == word(1) << 63);
+}
+TEST_CASE("find_runs", "[find_runs]")
+{
+  REQUIRE(find_runs(0, 3) == 0);
+  REQUIRE(find_runs(0b1, 1) == 0b1);
+  REQUIRE(find_runs(0b110111, 3) == 0b000001);
+  REQUIRE(find_runs(0b111111, 3) == 0b001111);
+  REQUIRE(find_runs(0b1110111, 4) == 0);
+  REQUIRE(find_runs(~word(0), 64) == 1);
+  REQUIRE(find_runs(~word(0) >> 1, 64) == 0);
+  REQUIRE(find_runs(word(0b111) << 61, 3) == word(1) << 61);
+}
+TEST_CASE("longest_zero_run", "[longest_zero_run]")
+{
+  auto longest = [](std::initializer_list<word> words) {
+    return longest_zero_run(words.begin(), words.end());
+  };
+  REQUIRE(longest({}) == 0);
+  REQUIRE(longest({0}) == 64);
+  REQUIRE(longest({~word(0)}) == 0);
+  REQUIRE(longest({~word(0) << 1}) == 1);
+  REQUIRE(longest({0b1000001}) == 57);
+  REQUIRE(longest({~word(0b111110)}) == 5);
+    REQUIRE(longest({1, 0, word(1) << 63}) == 63 + 64 + 63);
+  REQUIRE(longest({word(1) << 63, 0, 1}) == 64);
+  REQUIRE(longest({~word(0) >> 3, ~word(0) << 2}) == 5);
+  REQUIRE(longest({~word(0) >> 1, ~word(0)}) == 1);
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "../heap.h" // heap
+#include "../traits.h" // is_resource_v, resource_traits
+#include "static_vector.h" // static_vector
+
+#include <cassert> // assert
+#include <cstddef> // size_t, ptrdiff_t
+#include <memory> // pointer_traits, addressof
+#include <type_traits> // conditional_t
+#include <utility> // move, forward, exchange
+
+namespace kp11
+{
+  /// Pass as `MaxChunks` to `free_block` or `monotonic` so that the number of chunks isn't limited.
+  /// The index of chunks then grows geometrically with memory allocated from `heap`, rather than
+  /// from `Upstream`, so that `Upstream` only ever allocates chunks.
+  inline constexpr std::size_t dynamic_chunks = static_cast<std::size_t>(-1);
+}
+
+namespace kp11::detail
+{
+  /// Minimal vector implementation whose storage is allocated from `Resource` by `grow`.
+  template<typename T, typename Resource = heap>
+  class dynamic_vector
+  {
+    static_assert(is_resource_v<Resource>);
+
+  public: // types
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = T const *;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    /// Could change this, but we'll keep it simple.
+    using iterator = pointer;
+    /// Could change this, but we'll keep it simple.
+    using const_iterator = const_pointer;
+
+  private: // typedefs
+    using storage_pointer = typename Resource::pointer;
+    using value_pointer = typename std::pointer_traits<storage_pointer>::template rebind<T>;
+
+  public: // constants
+    /// Capacity of the first allocation.
+    static constexpr size_type initial_capacity = 4;
+
+  public: // constructors
+    dynamic_vector() noexcept
+    {
+    }
+    /// Deleted because the storage is being held and managed.
+    dynamic_vector(dynamic_vector const &) = delete;
+    /// `xs` is left empty without storage.
+    dynamic_vector(dynamic_vector && xs) noexcept :
+        storage(std::exchange(xs.storage, nullptr)), values(std::exchange(xs.values, nullptr)),
+        length(std::exchange(xs.length, 0)), cap(std::exchange(xs.cap, 0)),
+        resource(std::move(xs.resource))
+    {
+    }
+    /// Deleted because the storage is being held and managed.
+    dynamic_vector & operator=(dynamic_vector const &) = delete;
+    /// `xs` is left empty without storage.
+    dynamic_vector & operator=(dynamic_vector && xs) noexcept
+    {
+      if (this != &xs)
+      {
+        free();
+        storage = std::exchange(xs.storage, nullptr);
+        values = std::exchange(xs.values, nullptr);
+        length = std::exchange(xs.length, 0);
+        cap = std::exchange(xs.cap, 0);
+        resource = std::move(xs.resource);
+      }
+      return *this;
+    }
+    /// Defined because the storage needs to be given back to `Resource`.
+    ~dynamic_vector()
+    {
+      free();
+    }
+
+  public: // iterators
+    iterator begin() noexcept
+    {
+      return values;
+    }
+    const_iterator begin() const noexcept
+    {
+      return values;
+    }
+    iterator end() noexcept
+    {
+      return values + size();
+    }
+    const_iterator end() const noexcept
+    {
+      return values + size();
+    }
+    const_iterator cbegin() const noexcept
+    {
+      return begin();
+    }
+    const_iterator cend() const noexcept
+    {
+      return end();
+    }
+
+  public: // capacity
+    [[nodiscard]] bool empty() const noexcept
+    {
+      return size() == 0;
+    }
+    size_type size() const noexcept
+    {
+      return length;
+    }
+    size_type capacity() const noexcept
+    {
+      return cap;
+    }
+
+  public: // element access
+    reference operator[](size_type n)
+    {
+      assert(n < size());
+      return values[n];
+    }
+    const_reference operator[](size_type n) const
+    {
+      assert(n < size());
+      return values[n];
+    }
+    reference front()
+    {
+      assert(size() > 0);
+      return values[0];
+    }
+    const_reference front() const
+    {
+      assert(size() > 0);
+      return values[0];
+    }
+    reference back()
+    {
+      assert(size() > 0);
+      return values[size() - 1];
+    }
+    const_reference back() const
+    {
+      assert(size() > 0);
+      return values[size() - 1];
+    }
+
+  public: // modifiers
+    template<class... Args>
+    reference emplace_back(Args &&... args)
+    {
+      assert(size() != capacity());
+      new (&values[length++]) T(std::forward<Args>(args)...);
+      return back();
+    }
+    void push_back(T const & x)
+    {
+      emplace_back(x);
+    }
+    void push_back(T && x)
+    {
+      emplace_back(std::move(x));
+    }
+    void pop_back()
+    {
+      assert(size() > 0);
+      values[--length].~T();
+    }
+    void clear()
+    {
+      for (; length > 0; --length)
+      {
+        values[length - 1].~T();
+      }
+    }
+    /// Make room for one more element. When full the capacity is doubled by moving the elements
+    /// into storage allocated from `Resource`.
+    /// * Complexity `O(1)` amortised
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false` if `Resource` fails allocation. Nothing is changed.
+    bool grow() noexcept
+    {
+      if (size() != capacity())
+      {
+        return true;
+      }
+      auto const n = cap == 0 ? initial_capacity : 2 * cap;
+      if (n < cap || n > resource_traits<Resource>::max_size() / sizeof(T))
+      {
+        return false;
+      }
+      auto const ptr = static_cast<storage_pointer>(resource.allocate(n * sizeof(T), alignof(T)));
+      if (!ptr)
+      {
+        return false;
+      }
+      auto const xs = std::addressof(*static_cast<value_pointer>(ptr));
+      for (size_type i = 0; i != length; ++i)
+      {
+        new (&xs[i]) T(std::move(values[i]));
+        values[i].~T();
+      }
+      if (storage)
+      {
+        resource.deallocate(storage, cap * sizeof(T), alignof(T));
+      }
+      storage = ptr;
+      values = xs;
+      cap = n;
+      return true;
+    }
+
+  public: // accessors
+    /// @returns Reference to `Resource`.
+    Resource & get_resource() noexcept
+    {
+      return resource;
+    }
+
+  private: // helpers
+    /// Destroy every element and give the storage back to `Resource`.
+    void free() noexcept
+    {
+      clear();
+      if (storage)
+      {
+        resource.deallocate(storage, cap * sizeof(T), alignof(T));
+      }
+      storage = nullptr;
+      values = nullptr;
+      cap = 0;
+    }
+
+  private: // variables
+    /// Storage as it was returned by the resource.
+    storage_pointer storage = nullptr;
+    T * values = nullptr;
+    std::size_t length = 0;
+    std::size_t cap = 0;
+    Resource resource;
+  };
+
+  /// Directory of chunks for `free_block` and `monotonic`. A `static_vector` of `N` unless `N` is
+  /// `dynamic_chunks`.
+  template<typename T, std::size_t N>
+  using chunk_vector =
+    std::conditional_t<N == dynamic_chunks, dynamic_vector<T>, static_vector<T, N>>;
+}
\ No newline at end of file
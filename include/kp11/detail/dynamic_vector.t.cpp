@@ -0,0 +1,73 @@
+#include "dynamic_vector.h"
+
+#include "../heap.h" // heap
+#include "../replay.h" // footprint
+
+#include <catch.hpp>
+
+#include <type_traits> // is_same_v
+
+using namespace kp11::detail;
+
+TEST_CASE("unit test", "[unit-test]")
+{
+  dynamic_vector<int, kp11::footprint<kp11::heap>> xs;
+  REQUIRE(xs.capacity() == 0);
+  REQUIRE(xs.size() == 0);
+  REQUIRE(xs.empty() == true);
+  REQUIRE(xs.grow() == true);
+  REQUIRE(xs.capacity() == xs.initial_capacity);
+  REQUIRE(xs.get_resource().bytes() == xs.initial_capacity * sizeof(int));
+  for (int i = 0; i < 100; ++i)
+  {
+    REQUIRE(xs.grow() == true);
+    xs.push_back(i);
+  }
+  REQUIRE(xs.size() == 100);
+  REQUIRE(xs.capacity() == 128);
+  REQUIRE(xs.get_resource().bytes() == 128 * sizeof(int));
+  REQUIRE(xs.front() == 0);
+  REQUIRE(xs.back() == 99);
+  for (int i = 0; i < 100; ++i)
+  {
+    REQUIRE(xs[static_cast<std::size_t>(i)] == i);
+  }
+  xs.pop_back();
+  REQUIRE(xs.size() == 99);
+  REQUIRE(xs.end() - xs.begin() == 99);
+
+  SECTION("move constructor")
+  {
+    auto ys = std::move(xs);
+    REQUIRE(ys.size() == 99);
+    REQUIRE(ys.capacity() == 128);
+    REQUIRE(xs.size() == 0);
+    REQUIRE(xs.capacity() == 0);
+  }
+  SECTION("move assignment")
+  {
+    dynamic_vector<int> ys;
+    REQUIRE(ys.grow() == true);
+    ys.push_back(1);
+    dynamic_vector<int> zs;
+    REQUIRE(zs.grow() == true);
+    zs = std::move(ys);
+    REQUIRE(zs.size() == 1);
+    REQUIRE(ys.capacity() == 0);
+  }
+  SECTION("clear")
+  {
+    xs.clear();
+    REQUIRE(xs.empty() == true);
+    REQUIRE(xs.capacity() == 128);
+  }
+}
+TEST_CASE("chunk_vector", "[chunk_vector]")
+{
+  REQUIRE(std::is_same_v<chunk_vector<int, 4>, static_vector<int, 4>>);
+  REQUIRE(std::is_same_v<chunk_vector<int, kp11::dynamic_chunks>, dynamic_vector<int>>);
+  static_vector<int, 1> xs;
+  REQUIRE(xs.grow() == true);
+  xs.push_back(1);
+  REQUIRE(xs.grow() == false);
+}
\ No newline at end of file
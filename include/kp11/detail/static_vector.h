@@ -155,6 +155,13 @@ namespace kp11::detail
         values[length - 1].~T();
       }
     }
+    /// Same interface as `dynamic_vector`, so that either can be used as a chunk directory.
+    ///
+    /// @returns `true` if there is room for one more element.
+    bool grow() const noexcept
+    {
+      return size() != capacity();
+    }
 
   private: // variables
     std::size_t length = 0;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "traits.h" // is_resource_v, resource_traits, is_owner_v, owner_traits
+#include "traits.h" // is_resource_v, resource_traits, is_owner_v, owner_traits, allocation_result
 
 #include <cassert> // assert
 
@@ -48,6 +48,25 @@ namespace kp11
       }
       return secondary.allocate(size, alignment);
     }
+    /// Call `allocate_at_least` on `Primary`. On failure call it on `Secondary`.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @pre `size <= max_size()`
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block and its usable size.
+    /// @returns (failure) `nullptr` and `0`.
+    allocation_result<pointer, size_type> allocate_at_least(
+      size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      if (auto r = resource_traits<Primary>::allocate_at_least(primary, size, alignment); r.ptr)
+      {
+        return r;
+      }
+      return resource_traits<Secondary>::allocate_at_least(secondary, size, alignment);
+    }
     /// If `ptr` is owned by `Primary` then calls `Primary::deallocate` otherwise calls
     /// `Secondary::deallocate`.
     ///
@@ -72,6 +91,40 @@ namespace kp11
         }
       }
     }
+    /// If `ptr` is owned by `Primary` then tries to grow it in place with `Primary` otherwise with
+    /// `Secondary`.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param old_size Corresponding argument to call to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    bool expand(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      if (primary[ptr])
+      {
+        return resource_traits<Primary>::expand(primary, ptr, old_size, new_size);
+      }
+      return resource_traits<Secondary>::expand(secondary, ptr, old_size, new_size);
+    }
+    /// If `ptr` is owned by `Primary` then tries to shrink it in place with `Primary` otherwise
+    /// with `Secondary`.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param old_size Corresponding argument to call to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    bool shrink(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      if (primary[ptr])
+      {
+        return resource_traits<Primary>::shrink(primary, ptr, old_size, new_size);
+      }
+      return resource_traits<Secondary>::shrink(secondary, ptr, old_size, new_size);
+    }
 
   public: // observers
     /// Checks whether or not `ptr` is owned by `Primary` or `Secondary`.
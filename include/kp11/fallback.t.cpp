@@ -67,6 +67,30 @@ TEST_CASE("allocate", "[allocate]")
     }
   }
 }
+TEST_CASE("allocate_at_least", "[allocate]")
+{
+  fallback<primary_t, secondary_t> m;
+  auto a = m.allocate_at_least(100, 4);
+  REQUIRE(m.get_primary()[a.ptr] != nullptr);
+  REQUIRE(a.count == 128);
+  auto b = m.allocate_at_least(100, 4);
+  REQUIRE(m.get_secondary()[b.ptr] != nullptr);
+  REQUIRE(b.count == 128);
+  REQUIRE(m.allocate_at_least(100, 4).ptr == nullptr);
+}
+TEST_CASE("expand/shrink", "[expand/shrink]")
+{
+  fallback<primary_t, secondary_t> m;
+  auto a = m.allocate(32, 4);
+  REQUIRE(m.expand(a, 32, 64) == true);
+  REQUIRE(m.get_primary().bytes_in_use() == 64);
+  auto b = m.allocate(64, 4);
+  auto c = m.allocate(64, 4);
+  REQUIRE(m.get_secondary()[c] != nullptr);
+  REQUIRE(m.expand(c, 64, 128) == false);
+  REQUIRE(m.shrink(b, 64, 32) == true);
+  REQUIRE(m.get_primary().bytes_in_use() == 96);
+}
 TEST_CASE("deallocate", "[deallocate]")
 {
   SECTION("secondary is an owner")
@@ -0,0 +1,85 @@
+#include "free_block.h"
+
+#include "bitset.h" // bitset
+#include "heap.h" // heap
+#include "pool.h" // pool
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // shuffle
+#include <cstddef> // size_t
+#include <memory> // make_unique
+#include <random> // mt19937
+#include <vector> // vector
+
+using namespace kp11;
+
+namespace
+{
+  /// Every chunk is filled and the pointers are shuffled so that lookups are spread over all chunks.
+  template<std::size_t MaxChunks>
+  struct filled
+  {
+    using resource = free_block<256, 64, MaxChunks, bitset<4>, heap>;
+    std::unique_ptr<resource> r = std::make_unique<resource>();
+    std::vector<void *> ptrs;
+    filled()
+    {
+      while (auto p = r->allocate(64, 64))
+      {
+        ptrs.push_back(p);
+      }
+      std::shuffle(ptrs.begin(), ptrs.end(), std::mt19937());
+    }
+  };
+}
+
+template<std::size_t MaxChunks>
+static void free_block_lookup(benchmark::State & state)
+{
+  filled<MaxChunks> f;
+  std::size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize((*f.r)[f.ptrs[i]]);
+    i = (i + 1) % f.ptrs.size();
+  }
+}
+BENCHMARK_TEMPLATE(free_block_lookup, 1);
+BENCHMARK_TEMPLATE(free_block_lookup, 16);
+BENCHMARK_TEMPLATE(free_block_lookup, 256);
+BENCHMARK_TEMPLATE(free_block_lookup, 4096);
+
+template<std::size_t MaxChunks>
+static void free_block_deallocate_allocate(benchmark::State & state)
+{
+  filled<MaxChunks> f;
+  std::size_t i = 0;
+  for (auto _ : state)
+  {
+    f.r->deallocate(f.ptrs[i], 64, 64);
+    f.ptrs[i] = f.r->allocate(64, 64);
+    benchmark::DoNotOptimize(f.ptrs[i]);
+    i = (i + 1) % f.ptrs.size();
+  }
+}
+BENCHMARK_TEMPLATE(free_block_deallocate_allocate, 1);
+BENCHMARK_TEMPLATE(free_block_deallocate_allocate, 16);
+BENCHMARK_TEMPLATE(free_block_deallocate_allocate, 256);
+BENCHMARK_TEMPLATE(free_block_deallocate_allocate, 4096);
+
+// The first allocation of each iteration grows into a new chunk, which includes constructing its
+// marker.
+template<typename Marker>
+static void free_block_grow(benchmark::State & state)
+{
+  auto r = std::make_unique<free_block<16 * Marker::size(), 16, 1, Marker, heap>>();
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(r->allocate(16, 16));
+    r->release();
+  }
+}
+BENCHMARK_TEMPLATE(free_block_grow, pool<255>);
+BENCHMARK_TEMPLATE(free_block_grow, pool<65536>);
+BENCHMARK_TEMPLATE(free_block_grow, bitset<65536>);
\ No newline at end of file
@@ -1,11 +1,14 @@
 #pragma once
 
-#include "detail/static_vector.h" // static_vector
-#include "traits.h" // is_marker_v, is_resource_v
+#include "detail/dynamic_vector.h" // chunk_vector
+#include "stack.h" // stack
+#include "traits.h" // is_marker_v, is_resource_v, marker_traits, allocation_result
 
+#include <algorithm> // upper_bound, rotate, find
 #include <cassert> // assert
 #include <cstddef> // size_t, byte
 #include <functional> // less, less_equal
+#include <iterator> // prev, next
 #include <memory> // pointer_traits
 
 namespace kp11
@@ -13,6 +16,13 @@ namespace kp11
   /// @private
   namespace free_block_detail
   {
+    /// @private
+    template<typename Marker>
+    inline constexpr bool is_stack_v = false;
+    /// @private
+    template<std::size_t N>
+    inline constexpr bool is_stack_v<stack<N>> = true;
+
     /// @private
     template<typename BytePointer,
       typename SizeType,
@@ -25,9 +35,18 @@ namespace kp11
       using byte_pointer = BytePointer;
       using size_type = SizeType;
 
+    public: // variables
+      /// Previous memory block in the list of memory blocks that aren't full.
+      std::size_t prev = 0;
+      /// Next memory block in the list of memory blocks that aren't full.
+      std::size_t next = 0;
+
     private: // variables
       byte_pointer ptr;
       Marker marker;
+      /// Same as `marker.count()` but always `O(1)`. Less than it for `stack`, which doesn't
+      /// recover indexes that are deallocated out of order.
+      typename Marker::size_type num_allocated = 0;
 
     public: // constructors
       explicit resource(byte_pointer ptr) noexcept : ptr(ptr)
@@ -43,6 +62,22 @@ namespace kp11
       {
         return marker;
       }
+      /// `stack` is full when its `O(1)` count is, even if some of the indexes were deallocated.
+      bool full() const noexcept
+      {
+        if constexpr (is_stack_v<Marker>)
+        {
+          return marker.count() == Marker::size();
+        }
+        else
+        {
+          return num_allocated == Marker::size();
+        }
+      }
+      auto count() const noexcept
+      {
+        return num_allocated;
+      }
 
     public: // modifiers
       byte_pointer allocate(size_type size) noexcept
@@ -50,15 +85,75 @@ namespace kp11
         auto const n = to_blocks(size);
         if (auto i = marker.allocate(n); i != Marker::size())
         {
+          num_allocated += n;
           return ptr + static_cast<size_type>(block_size * i);
         }
         return nullptr;
       }
-      bool deallocate(byte_pointer ptr, size_type size) noexcept
+      /// Allocate from the marker in batches so that the indexes fit on the stack.
+      ///
+      /// @returns Number of allocations written to the front of `out`.
+      template<typename Pointer>
+      std::size_t allocate_bulk(size_type size, std::size_t count, Pointer * out) noexcept
       {
-        if (contains(ptr))
+        using index_type = typename Marker::size_type;
+        constexpr std::size_t batch = 64;
+        auto const n = to_blocks(size);
+        index_type indexes[batch];
+        std::size_t done = 0;
+        while (done != count)
+        {
+          auto const want = static_cast<index_type>(count - done < batch ? count - done : batch);
+          auto const got = marker_traits<Marker>::allocate_bulk(marker, n, want, indexes);
+          for (index_type k = 0; k != got; ++k)
+          {
+            out[done + k] =
+              static_cast<Pointer>(ptr + static_cast<size_type>(block_size * indexes[k]));
+          }
+          num_allocated += static_cast<index_type>(got * n);
+          done += got;
+          if (got != want)
+          {
+            break;
+          }
+        }
+        return done;
+      }
+      void deallocate(byte_pointer ptr, size_type size) noexcept
+      {
+        assert(contains(ptr));
+        auto const n = to_blocks(size);
+        marker.deallocate(to_index(ptr), n);
+        num_allocated -= n;
+        if constexpr (is_stack_v<Marker>)
         {
-          marker.deallocate(to_index(ptr), to_blocks(size));
+          // Recover the indexes that were deallocated out of order once none are in use.
+          if (num_allocated == 0)
+          {
+            marker = Marker();
+          }
+        }
+      }
+      bool expand(byte_pointer ptr, size_type old_size, size_type new_size) noexcept
+      {
+        assert(contains(ptr));
+        auto const old_n = to_blocks(old_size);
+        auto const new_n = to_blocks(new_size);
+        if (marker_traits<Marker>::expand(marker, to_index(ptr), old_n, new_n))
+        {
+          num_allocated += new_n - old_n;
+          return true;
+        }
+        return false;
+      }
+      bool shrink(byte_pointer ptr, size_type old_size, size_type new_size) noexcept
+      {
+        assert(contains(ptr));
+        auto const old_n = to_blocks(old_size);
+        auto const new_n = to_blocks(new_size);
+        if (marker_traits<Marker>::shrink(marker, to_index(ptr), old_n, new_n))
+        {
+          num_allocated -= old_n - new_n;
           return true;
         }
         return false;
@@ -88,11 +183,19 @@ namespace kp11
   }
   /// @brief Splits single allocations from `Upstream` into multiple blocks that can be allocated.
   ///
-  /// Each memory block allocated from `Upstream` has a `Marker` to manage blocks.
+  /// Each memory block allocated from `Upstream` has a `Marker` to manage blocks. An index of the
+  /// memory blocks sorted by address is kept so that the owner of a pointer can be found with a
+  /// binary search. Memory blocks that aren't full are kept in a list so that full memory blocks are
+  /// never searched by `allocate`.
+  ///
+  /// Blocks can be smaller than `ChunkAlignment`, so that small objects can be allocated from
+  /// e.g. page aligned chunks. Requests aligned to more than `block_alignment` fail, so that they
+  /// can be passed on to another resource by `fallback`.
   ///
   /// @tparam ChunkSize Size in bytes of request to `Upstream`.
-  /// @tparam ChunkAlignment Alignment in bytes of request to `Upstream` and alignment of blocks.
-  /// @tparam MaxChunks Maximum number of concurrent allocations from `Upstream`.
+  /// @tparam ChunkAlignment Alignment in bytes of request to `Upstream`.
+  /// @tparam MaxChunks Maximum number of concurrent allocations from `Upstream`, or
+  /// `dynamic_chunks` for no limit.
   /// @tparam Marker Meets the `Marker` concept.
   /// @tparam Upstream Meets the `Resource` concept.
   template<std::size_t ChunkSize,
@@ -106,8 +209,6 @@ namespace kp11
     static_assert(is_resource_v<Upstream>);
     static_assert(ChunkSize % ChunkAlignment == 0);
     static_assert(ChunkSize % Marker::size() == 0);
-    // Block size must be aligned to chunk alignment.
-    static_assert(ChunkSize / Marker::size() % ChunkAlignment == 0);
 
   public: // typedefs
     /// Pointer type.
@@ -118,12 +219,17 @@ namespace kp11
   public: // constants
     /// Size in bytes of request to `Upstream`.
     static constexpr auto chunk_size = ChunkSize;
-    /// Alignment in bytes of request to `Upstream` and alignment of blocks.
+    /// Alignment in bytes of request to `Upstream`.
     static constexpr auto chunk_alignment = ChunkAlignment;
     /// Maximum number of concurrent allocations from `Upstream`.
     static constexpr auto max_chunks = MaxChunks;
     /// Size in bytes of a free block.
     static constexpr auto block_size = chunk_size / Marker::size();
+    /// Alignment in bytes of every block, which is the largest power of two that divides
+    /// `block_size`, up to `chunk_alignment`.
+    static constexpr auto block_alignment =
+      (block_size & (~block_size + 1)) < chunk_alignment ? (block_size & (~block_size + 1))
+                                                         : chunk_alignment;
 
   private: // typedefs
     /// Byte pointer for arithmetic purposes.
@@ -138,9 +244,12 @@ namespace kp11
     free_block(free_block const &) = delete;
     /// Defined because the destructor is defined. `x` is left is a valid but unspecified state.
     free_block(free_block && x) noexcept :
-        resources(std::move(x.resources)), upstream(std::move(x.upstream))
+        resources(std::move(x.resources)), sorted(std::move(x.sorted)), head(x.head),
+        tail(x.tail), upstream(std::move(x.upstream))
     {
       x.resources.clear();
+      x.sorted.clear();
+      x.head = x.tail = max_chunks;
     }
     /// Deleted because a resource is being held and managed.
     free_block & operator=(free_block const &) = delete;
@@ -151,8 +260,13 @@ namespace kp11
       {
         release();
         resources = std::move(x.resources);
+        sorted = std::move(x.sorted);
+        head = x.head;
+        tail = x.tail;
         upstream = std::move(x.upstream);
         x.resources.clear();
+        x.sorted.clear();
+        x.head = x.tail = max_chunks;
       }
       return *this;
     }
@@ -170,44 +284,106 @@ namespace kp11
     }
 
   public: // modifiers
-    /// Try to allocate from existing allocations. If unsuccessful try to allocate a new memory
-    /// block from `Upstream` and allocate from that.
-    /// * Complexity `O(n)`
+    /// Try to allocate from existing allocations that aren't full, starting with the ones that have
+    /// most recently had memory deallocated. If unsuccessful try to allocate a new memory block
+    /// from `Upstream` and allocate from that.
+    /// * Complexity `O(n)` where `n` is the number of memory blocks that aren't full.
     ///
     /// @param size Size in bytes of memory to allocate.
     /// @param alignment Alignment in bytes of memory to allocate.
     ///
     /// @returns (success) Pointer to the beginning of a suitable memory block.
-    /// @returns (failure) `nullptr`
+    /// @returns (failure) `nullptr`, also if `alignment` is greater than `block_alignment`.
     ///
-    /// @pre `chunk_alignment % alignment == 0`
     /// @pre `size <= max_size()`
     ///
     /// @post (success) (return value) will not be returned again until it has been `deallocated`.
     /// Depends on `Marker`.
-    pointer allocate(size_type size, [[maybe_unused]] size_type alignment) noexcept
+    pointer allocate(size_type size, size_type alignment) noexcept
     {
-      assert(chunk_alignment % alignment == 0);
       assert(size <= max_size());
-      for (auto && r : resources)
+      if (block_alignment % alignment != 0)
+      {
+        return nullptr;
+      }
+      for (auto i = head; i != max_chunks; i = resources[i].next)
       {
-        if (auto p = r.allocate(size))
+        if (auto p = allocate_from(i, size))
         {
           return static_cast<pointer>(p);
         }
       }
       if (push_back())
       {
-        auto p = resources.back().allocate(size);
+        auto p = allocate_from(resources.size() - 1, size);
         // New resources should be able to fulfil any request.
         assert(p != nullptr);
         return static_cast<pointer>(p);
       }
       return nullptr;
     }
+    /// Same as `allocate` but also returns the usable size, which is `size` rounded up to a whole
+    /// number of blocks.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment in bytes of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block and its usable size.
+    /// @returns (failure) `nullptr` and `0`.
+    ///
+    /// @pre `size <= max_size()`
+    allocation_result<pointer, size_type> allocate_at_least(
+      size_type size, size_type alignment) noexcept
+    {
+      if (auto ptr = allocate(size, alignment))
+      {
+        return {ptr, round_up(size)};
+      }
+      return {nullptr, 0};
+    }
+    /// Allocate `n` blocks of `size` bytes in a single walk over the memory blocks that aren't
+    /// full. Each memory block is filled as far as `Marker` allows with `Marker::allocate_bulk`
+    /// before moving onto the next, and then new memory blocks are allocated from `Upstream` as
+    /// needed.
+    /// * Complexity `O(m + n)` calls to `Marker` where `m` is the number of memory blocks that
+    /// aren't full.
+    ///
+    /// @param size Size in bytes of each allocation.
+    /// @param alignment Alignment in bytes of each allocation.
+    /// @param n Number of allocations.
+    /// @param out Written with the pointer to each allocation.
+    ///
+    /// @returns Number of allocations written to the front of `out`. Less than `n` if we ran out
+    /// of memory. `0` if `alignment` is greater than `block_alignment`.
+    ///
+    /// @pre `size <= max_size()`
+    size_type allocate_bulk(
+      size_type size, size_type alignment, size_type n, pointer * out) noexcept
+    {
+      assert(size <= max_size());
+      if (block_alignment % alignment != 0)
+      {
+        return 0;
+      }
+      size_type done = 0;
+      for (auto i = head; i != max_chunks && done != n;)
+      {
+        auto const next = resources[i].next;
+        done += allocate_bulk_from(i, size, n - done, out + done);
+        i = next;
+      }
+      while (done != n && push_back())
+      {
+        auto const got = allocate_bulk_from(resources.size() - 1, size, n - done, out + done);
+        // New resources should be able to fulfil at least one request.
+        assert(got != 0);
+        done += got;
+      }
+      return done;
+    }
     /// If `ptr` points into one of our allocations then deallocate it.
     /// `nullptr` is determined to not be owned.
-    /// * Complexity `O(n)`
+    /// * Complexity `O(log n)`
     ///
     /// @param ptr Pointer to the beginning of a memory block.
     /// @param size Size in bytes of the memory block.
@@ -220,10 +396,78 @@ namespace kp11
     /// corresponding arguments to `allocate`.
     bool deallocate(pointer ptr, size_type size, [[maybe_unused]] size_type alignment) noexcept
     {
-      for (auto && r : resources)
+      if (auto const i = find(static_cast<byte_pointer>(ptr)); i != resources.size())
+      {
+        auto & r = resources[i];
+        auto const was_full = r.full();
+        r.deallocate(static_cast<byte_pointer>(ptr), size);
+        if (was_full && !r.full())
+        {
+          link_front(i);
+        }
+        return true;
+      }
+      return false;
+    }
+    /// If `ptr` points into one of our allocations then try to grow it in place with
+    /// `Marker::expand`, e.g. into the unallocated blocks right after it.
+    /// * Complexity `O(log n)` + `O(Marker::expand)`
+    ///
+    /// @param ptr Pointer to the beginning of a memory block.
+    /// @param old_size Corresponding argument to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns (success) `true` and `ptr` must now be deallocated with `new_size`.
+    /// @returns (failure) `false` and nothing was changed.
+    ///
+    /// @pre `old_size <= new_size`
+    bool expand(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      assert(old_size <= new_size);
+      if (new_size > max_size())
+      {
+        return false;
+      }
+      if (auto const i = find(static_cast<byte_pointer>(ptr)); i != resources.size())
+      {
+        auto & r = resources[i];
+        auto const was_full = r.full();
+        if (r.expand(static_cast<byte_pointer>(ptr), old_size, new_size))
+        {
+          if (!was_full && r.full())
+          {
+            unlink(i);
+          }
+          return true;
+        }
+      }
+      return false;
+    }
+    /// If `ptr` points into one of our allocations then try to shrink it in place with
+    /// `Marker::shrink`.
+    /// * Complexity `O(log n)` + `O(Marker::shrink)`
+    ///
+    /// @param ptr Pointer to the beginning of a memory block.
+    /// @param old_size Corresponding argument to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns (success) `true` and `ptr` must now be deallocated with `new_size`.
+    /// @returns (failure) `false` and nothing was changed.
+    ///
+    /// @pre `new_size <= old_size`
+    bool shrink(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      assert(new_size <= old_size);
+      if (auto const i = find(static_cast<byte_pointer>(ptr)); i != resources.size())
       {
-        if (r.deallocate(static_cast<byte_pointer>(ptr), size))
+        auto & r = resources[i];
+        auto const was_full = r.full();
+        if (r.shrink(static_cast<byte_pointer>(ptr), old_size, new_size))
         {
+          if (was_full && !r.full())
+          {
+            link_front(i);
+          }
           return true;
         }
       }
@@ -237,13 +481,15 @@ namespace kp11
         upstream.deallocate(static_cast<pointer>(r.get_ptr()), chunk_size, chunk_alignment);
       }
       resources.clear();
+      sorted.clear();
+      head = tail = max_chunks;
     }
 
     /// Deallocate the most recently allocated memory back to `Upstream` if their markers have all
     /// unallocated indexes.
     void shrink_to_fit() noexcept
     {
-      while (!resources.empty() && resources.back().get_marker().count() == 0)
+      while (!resources.empty() && resources.back().count() == 0)
       {
         pop_back();
       }
@@ -251,6 +497,7 @@ namespace kp11
 
   public: // observers
     /// Check whether or not `ptr` points into an allocation from `Upstream`.
+    /// * Complexity `O(log n)`
     ///
     /// @param ptr Pointer to memory.
     ///
@@ -258,15 +505,57 @@ namespace kp11
     /// @returns (failure) `nullptr`
     pointer operator[](pointer ptr) const noexcept
     {
-      for (auto && r : resources)
+      if (auto const i = find(static_cast<byte_pointer>(ptr)); i != resources.size())
       {
-        if (r.contains(static_cast<byte_pointer>(ptr)))
-        {
-          return static_cast<pointer>(r.get_ptr());
-        }
+        return static_cast<pointer>(resources[i].get_ptr());
       }
       return nullptr;
     }
+    /// @returns Number of chunks allocated from `Upstream`.
+    std::size_t chunk_count() const noexcept
+    {
+      return resources.size();
+    }
+    /// @returns Number of bytes in allocated blocks. Requests are rounded up to a whole number of
+    /// blocks.
+    /// * Complexity `O(n)`
+    size_type bytes_in_use() const noexcept
+    {
+      size_type n = 0;
+      for (auto && r : resources)
+      {
+        n += static_cast<size_type>(r.count());
+      }
+      return static_cast<size_type>(n * block_size);
+    }
+    /// Only memory blocks that aren't full are searched.
+    /// * Complexity `O(n)` calls to `Marker::largest_free_run`.
+    ///
+    /// @returns Size in bytes of the largest request that can be allocated without another chunk
+    /// from `Upstream`. Depends on `Marker`, see `marker_traits::largest_free_run`.
+    size_type largest_free_run() const noexcept
+    {
+      size_type n = 0;
+      for (auto i = head; i != max_chunks; i = resources[i].next)
+      {
+        auto const m =
+          static_cast<size_type>(marker_traits<Marker>::largest_free_run(resources[i].get_marker()));
+        n = m > n ? m : n;
+      }
+      return static_cast<size_type>(n * block_size);
+    }
+    /// Call `f(chunk, marker)` for every chunk in order of address, where `chunk` is the pointer
+    /// returned by `Upstream` and `marker` is a const reference to its `Marker`.
+    ///
+    /// @param f Function object to call.
+    template<typename F>
+    void for_each_chunk(F && f) const
+    {
+      for (auto i : sorted)
+      {
+        f(static_cast<pointer>(resources[i].get_ptr()), resources[i].get_marker());
+      }
+    }
 
   public: // accessors
     /// @returns Reference to `Upstream`.
@@ -282,19 +571,23 @@ namespace kp11
 
   private: // modifiers
     /// Allocate from `Upstream` and construct another resource. Fail if max chunks has been reached
-    /// or if `Upstream` fails allocation.
+    /// or if `Upstream` fails allocation, including growing a `dynamic_chunks` index.
     ///
     /// @returns (success) `true`
     /// @returns (failure) `false`
     bool push_back() noexcept
     {
-      if (resources.size() == resources.capacity())
+      if (!resources.grow() || !sorted.grow())
       {
         return false;
       }
       if (auto ptr = static_cast<byte_pointer>(upstream.allocate(chunk_size, chunk_alignment)))
       {
+        auto const pos = upper_bound(ptr) - sorted.cbegin();
+        sorted.push_back(resources.size());
+        std::rotate(sorted.begin() + pos, std::prev(sorted.end()), sorted.end());
         resources.emplace_back(ptr);
+        link_back(resources.size() - 1);
         return true;
       }
       return false;
@@ -308,11 +601,106 @@ namespace kp11
       assert(!resources.empty());
       upstream.deallocate(
         static_cast<pointer>(resources.back().get_ptr()), chunk_size, chunk_alignment);
+      auto const pos = std::find(sorted.begin(), sorted.end(), resources.size() - 1);
+      std::rotate(pos, std::next(pos), sorted.end());
+      sorted.pop_back();
+      if (!resources.back().full())
+      {
+        unlink(resources.size() - 1);
+      }
       resources.pop_back();
     }
+    /// Allocate from `resources[i]` and take it off of the list if it becomes full.
+    ///
+    /// @pre `resources[i]` isn't full.
+    byte_pointer allocate_from(std::size_t i, size_type size) noexcept
+    {
+      auto & r = resources[i];
+      assert(!r.full());
+      auto p = r.allocate(size);
+      if (r.full())
+      {
+        unlink(i);
+      }
+      return p;
+    }
+    /// Allocate up to `n` blocks from `resources[i]` and take it off of the list if it becomes
+    /// full.
+    ///
+    /// @pre `resources[i]` isn't full.
+    size_type allocate_bulk_from(std::size_t i, size_type size, size_type n, pointer * out) noexcept
+    {
+      auto & r = resources[i];
+      assert(!r.full());
+      auto const got = static_cast<size_type>(r.allocate_bulk(size, n, out));
+      if (r.full())
+      {
+        unlink(i);
+      }
+      return got;
+    }
+    /// Put `resources[i]` at the front of the list of memory blocks that aren't full.
+    void link_front(std::size_t i) noexcept
+    {
+      resources[i].prev = max_chunks;
+      resources[i].next = head;
+      (head != max_chunks ? resources[head].prev : tail) = i;
+      head = i;
+    }
+    /// Put `resources[i]` at the back of the list of memory blocks that aren't full.
+    void link_back(std::size_t i) noexcept
+    {
+      resources[i].prev = tail;
+      resources[i].next = max_chunks;
+      (tail != max_chunks ? resources[tail].next : head) = i;
+      tail = i;
+    }
+    /// Take `resources[i]` off of the list of memory blocks that aren't full.
+    void unlink(std::size_t i) noexcept
+    {
+      auto const prev = resources[i].prev;
+      auto const next = resources[i].next;
+      (prev != max_chunks ? resources[prev].next : head) = next;
+      (next != max_chunks ? resources[next].prev : tail) = prev;
+    }
+
+  private: // observers
+    /// @returns Position of the first index in `sorted` whose memory block begins after `ptr`.
+    auto upper_bound(byte_pointer ptr) const noexcept
+    {
+      return std::upper_bound(sorted.begin(), sorted.end(), ptr, [this](auto ptr, auto i) {
+        return std::less<byte_pointer>()(ptr, resources[i].get_ptr());
+      });
+    }
+    /// The only memory block that can contain `ptr` is the one that begins right before it.
+    ///
+    /// @returns (success) Index into `resources` of the memory block that contains `ptr`.
+    /// @returns (failure) `resources.size()`
+    std::size_t find(byte_pointer ptr) const noexcept
+    {
+      if (auto const pos = upper_bound(ptr); pos != sorted.begin())
+      {
+        if (auto const i = *std::prev(pos); resources[i].contains(ptr))
+        {
+          return i;
+        }
+      }
+      return resources.size();
+    }
+    /// @returns `size` rounded up to a whole number of blocks.
+    static size_type round_up(size_type size) noexcept
+    {
+      return ((size == 0) + size / block_size + (size % block_size != 0)) * block_size;
+    }
 
   private: // variables
-    kp11::detail::static_vector<resource, max_chunks> resources;
+    kp11::detail::chunk_vector<resource, max_chunks> resources;
+    /// Indexes into `resources` sorted by the address of their memory block.
+    kp11::detail::chunk_vector<std::size_t, max_chunks> sorted;
+    /// First memory block that isn't full otherwise `max_chunks`.
+    std::size_t head = max_chunks;
+    /// Last memory block that isn't full otherwise `max_chunks`.
+    std::size_t tail = max_chunks;
     Upstream upstream;
   };
 }
\ No newline at end of file
@@ -1,11 +1,21 @@
 #include "free_block.h"
 
+#include "bitset.h" // bitset
+#include "fallback.h" // fallback
 #include "heap.h" // heap
+#include "list.h" // list
+#include "replay.h" // footprint
 #include "stack.h" // stack
-#include "traits.h" // is_owner_v
+#include "traits.h" // is_owner_v, resource_traits
 
 #include <catch.hpp>
 
+#include <algorithm> // sort, adjacent_find
+#include <cstddef> // byte, size_t
+#include <cstdint> // uintptr_t
+#include <functional> // less
+#include <vector> // vector
+
 using namespace kp11;
 
 TEST_CASE("max_size", "[max_size]")
@@ -49,6 +59,75 @@ TEST_CASE("operator[]", "[operator[]]")
     REQUIRE(m[a] != nullptr);
   }
 }
+TEST_CASE("operator[] many chunks", "[operator[]]")
+{
+  free_block<128, 4, 8, stack<4>, heap> m;
+  void * ptrs[8];
+  for (auto & p : ptrs)
+  {
+    p = m.allocate(128, 4);
+    REQUIRE(p != nullptr);
+  }
+  for (auto p : ptrs)
+  {
+    REQUIRE(m[p] == p);
+    REQUIRE(m[static_cast<std::byte *>(p) + 127] == p);
+  }
+  SECTION("after shrink_to_fit")
+  {
+    m.deallocate(ptrs[7], 128, 4);
+    m.shrink_to_fit();
+    for (int i = 0; i < 7; ++i)
+    {
+      REQUIRE(m[ptrs[i]] == ptrs[i]);
+    }
+    auto a = m.allocate(128, 4);
+    REQUIRE(a != nullptr);
+    REQUIRE(m[a] == a);
+    REQUIRE(m.deallocate(a, 128, 4) == true);
+  }
+}
+TEST_CASE("dynamic_chunks", "[dynamic_chunks]")
+{
+  free_block<128, 4, dynamic_chunks, stack<4>, footprint<heap>> m;
+  REQUIRE(sizeof(m) < sizeof(free_block<128, 4, 8, stack<4>, footprint<heap>>));
+  std::vector<void *> ptrs;
+  for (int i = 0; i < 100; ++i)
+  {
+    ptrs.push_back(m.allocate(128, 4));
+    REQUIRE(ptrs.back() != nullptr);
+  }
+  // The index of chunks isn't allocated from upstream.
+  REQUIRE(m.get_upstream().bytes() == 100 * 128);
+  for (auto p : ptrs)
+  {
+    REQUIRE(m[p] == p);
+  }
+  for (auto p : ptrs)
+  {
+    REQUIRE(m.deallocate(p, 128, 4) == true);
+  }
+  SECTION("shrink_to_fit")
+  {
+    m.shrink_to_fit();
+    REQUIRE(m.get_upstream().bytes() == 0);
+    REQUIRE(m.allocate(128, 4) != nullptr);
+  }
+  SECTION("move")
+  {
+    auto n = std::move(m);
+    REQUIRE(n[ptrs[50]] == ptrs[50]);
+    REQUIRE(m[ptrs[50]] == nullptr);
+    REQUIRE(m.allocate(128, 4) != nullptr);
+  }
+  SECTION("move assignment")
+  {
+    decltype(m) n;
+    REQUIRE(n.allocate(128, 4) != nullptr);
+    n = std::move(m);
+    REQUIRE(n[ptrs[50]] == ptrs[50]);
+  }
+}
 TEST_CASE("allocate", "[allocate]")
 {
   free_block<128, 4, 2, stack<4>, heap> m;
@@ -66,6 +145,157 @@ TEST_CASE("allocate", "[allocate]")
     }
   }
 }
+TEST_CASE("alignment", "[allocate]")
+{
+  free_block<4096, 4096, 1, bitset<256>, heap> m; // 16 byte blocks
+  REQUIRE(m.block_alignment == 16);
+  REQUIRE(free_block<768, 256, 1, bitset<16>, heap>::block_alignment == 16);
+  REQUIRE(free_block<4096, 64, 1, bitset<16>, heap>::block_alignment == 64);
+  auto a = static_cast<std::byte *>(m.allocate(16, 16));
+  REQUIRE(a != nullptr);
+  REQUIRE(m.allocate(16, 8) == a + 16);
+  REQUIRE(m.bytes_in_use() == 32);
+  SECTION("greater than block alignment")
+  {
+    REQUIRE(m.allocate(16, 32) == nullptr);
+    void * ptrs[2] = {};
+    REQUIRE(m.allocate_bulk(16, 32, 2, ptrs) == 0);
+  }
+  SECTION("passed on by fallback")
+  {
+    fallback<free_block<4096, 4096, 1, bitset<256>, heap>, heap> f;
+    auto b = f.allocate(16, 64);
+    REQUIRE(b != nullptr);
+    REQUIRE(f.get_primary()[b] == nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+    f.deallocate(b, 16, 64);
+  }
+}
+TEST_CASE("allocate_at_least", "[allocate]")
+{
+  free_block<128, 4, 2, stack<4>, heap> m; // 32 byte blocks
+  auto a = m.allocate_at_least(40, 4);
+  REQUIRE(a.ptr != nullptr);
+  REQUIRE(a.count == 64);
+  REQUIRE(m.bytes_in_use() == 64);
+  SECTION("deallocate with the usable size")
+  {
+    REQUIRE(m.deallocate(a.ptr, a.count, 4) == true);
+    REQUIRE(m.bytes_in_use() == 0);
+  }
+  SECTION("failure")
+  {
+    m.allocate(128, 4);
+    auto b = m.allocate_at_least(128, 4);
+    REQUIRE(b.ptr == nullptr);
+    REQUIRE(b.count == 0);
+  }
+}
+TEST_CASE("allocate reuses chunks that are no longer full", "[allocate]")
+{
+  free_block<128, 4, 3, stack<4>, heap> m;
+  auto a = m.allocate(128, 4);
+  auto b = m.allocate(128, 4);
+  auto c = m.allocate(64, 4);
+  REQUIRE(c != nullptr);
+  SECTION("partially full chunk")
+  {
+    auto d = m.allocate(64, 4);
+    REQUIRE(m[d] == m[c]);
+  }
+  SECTION("full chunk")
+  {
+    m.deallocate(a, 128, 4);
+    auto d = m.allocate(128, 4);
+    REQUIRE(d == a);
+    m.deallocate(b, 128, 4);
+    auto e = m.allocate(128, 4);
+    REQUIRE(e == b);
+    REQUIRE(m.allocate(128, 4) == nullptr);
+  }
+}
+TEST_CASE("allocate_bulk", "[allocate_bulk]")
+{
+  free_block<128, 4, 3, bitset<32>, heap> m;
+  void * ptrs[96] = {};
+  SECTION("fills partially full chunks first")
+  {
+    auto a = m.allocate(4, 4);
+    REQUIRE(m.allocate_bulk(4, 4, 31, ptrs) == 31);
+    REQUIRE(m.chunk_count() == 1);
+    for (auto p : ptrs)
+    {
+      if (p)
+      {
+        REQUIRE(m[p] == m[a]);
+      }
+    }
+  }
+  SECTION("across chunks")
+  {
+    REQUIRE(m.allocate_bulk(4, 4, 70, ptrs) == 70);
+    REQUIRE(m.chunk_count() == 3);
+    REQUIRE(m.bytes_in_use() == 70 * 4);
+    std::vector<void *> v(ptrs, ptrs + 70);
+    std::sort(v.begin(), v.end(), std::less<void *>());
+    REQUIRE(std::adjacent_find(v.begin(), v.end()) == v.end());
+    resource_traits<decltype(m)>::deallocate_bulk(m, ptrs, 4, 4, 70);
+    REQUIRE(m.bytes_in_use() == 0);
+  }
+  SECTION("partial success")
+  {
+    REQUIRE(m.allocate_bulk(8, 4, 96, ptrs) == 48);
+    REQUIRE(m.allocate(4, 4) == nullptr);
+    m.deallocate(ptrs[20], 8, 4);
+    REQUIRE(m.allocate_bulk(8, 4, 2, ptrs) == 1);
+    REQUIRE(m.allocate(4, 4) == nullptr);
+  }
+}
+TEST_CASE("expand/shrink", "[expand/shrink]")
+{
+  free_block<128, 4, 2, list<4>, heap> m; // 32 byte blocks
+  auto a = m.allocate(32, 4);
+  auto b = m.allocate(32, 4);
+  REQUIRE(m.expand(b, 32, 64) == false);
+  m.deallocate(a, 32, 4);
+  REQUIRE(m.expand(b, 32, 64) == true);
+  REQUIRE(m.bytes_in_use() == 64);
+  REQUIRE(m.expand(b, 64, 256) == false);
+  SECTION("shrinking a full chunk lets it be allocated from again")
+  {
+    m.allocate(64, 4);
+    REQUIRE(m.largest_free_run() == 0);
+    REQUIRE(m.shrink(b, 64, 32) == true);
+    REQUIRE(m.bytes_in_use() == 96);
+    REQUIRE(m.allocate(32, 4) == static_cast<std::byte *>(b) + 32);
+    REQUIRE(m.chunk_count() == 1);
+  }
+  SECTION("not owned")
+  {
+    int x;
+    REQUIRE(m.expand(&x, 4, 8) == false);
+    REQUIRE(m.shrink(&x, 8, 4) == false);
+  }
+}
+TEST_CASE("shrink stack", "[expand/shrink]")
+{
+  free_block<128, 4, 2, stack<4>, heap> m; // 32 byte blocks
+  auto a = m.allocate(128, 4);
+  REQUIRE(m.shrink(a, 128, 64) == true);
+  REQUIRE(m.bytes_in_use() == 64);
+  auto b = m.allocate(64, 4);
+  REQUIRE(b == static_cast<std::byte *>(a) + 64);
+  SECTION("not the most recent allocation")
+  {
+    REQUIRE(m.shrink(a, 64, 32) == false);
+    REQUIRE(m.bytes_in_use() == 128);
+    REQUIRE(m.deallocate(b, 64, 4) == true);
+    REQUIRE(m.deallocate(a, 64, 4) == true);
+    REQUIRE(m.bytes_in_use() == 0);
+    REQUIRE(m.allocate(128, 4) == a);
+    REQUIRE(m.chunk_count() == 1);
+  }
+}
 TEST_CASE("deallocate", "[deallocate]")
 {
   free_block<128, 4, 2, stack<4>, heap> m;
@@ -111,6 +341,70 @@ TEST_CASE("shirnk_to_fit", "[shrink_to_fit]")
   auto c = m.allocate(128, 4);
   REQUIRE(c != nullptr);
 }
+TEST_CASE("stack deallocated out of order", "[deallocate]")
+{
+  free_block<128, 4, 2, stack<4>, heap> m; // 32 byte blocks
+  auto a = m.allocate(32, 4);
+  auto b = m.allocate(32, 4);
+  auto c = m.allocate(64, 4);
+  REQUIRE(m.deallocate(a, 32, 4) == true);
+  SECTION("chunk stays full")
+  {
+    auto d = m.allocate(32, 4);
+    REQUIRE(d != nullptr);
+    REQUIRE(m.chunk_count() == 2);
+    REQUIRE(m.deallocate(d, 32, 4) == true);
+  }
+  REQUIRE(m.deallocate(c, 64, 4) == true);
+  REQUIRE(m.deallocate(b, 32, 4) == true);
+  REQUIRE(m.bytes_in_use() == 0);
+  SECTION("indexes are recovered once none are in use")
+  {
+    auto const n = m.chunk_count();
+    REQUIRE(m.allocate(128, 4) != nullptr);
+    REQUIRE(m.chunk_count() == n);
+  }
+  SECTION("shrink_to_fit")
+  {
+    m.shrink_to_fit();
+    REQUIRE(m.chunk_count() == 0);
+  }
+}
+TEST_CASE("introspection", "[introspection]")
+{
+  free_block<128, 4, 2, bitset<8>, heap> m;
+  REQUIRE(m.chunk_count() == 0);
+  REQUIRE(m.bytes_in_use() == 0);
+  REQUIRE(m.largest_free_run() == 0);
+  auto a = m.allocate(32, 4);
+  auto b = m.allocate(16, 4);
+  REQUIRE(m.chunk_count() == 1);
+  REQUIRE(m.bytes_in_use() == 48);
+  REQUIRE(m.largest_free_run() == 80);
+  m.allocate(80, 4);
+  REQUIRE(m.largest_free_run() == 0);
+  auto c = m.allocate(20, 4);
+  REQUIRE(m.chunk_count() == 2);
+  REQUIRE(m.bytes_in_use() == 128 + 32);
+  REQUIRE(m.largest_free_run() == 96);
+  m.deallocate(a, 32, 4);
+  REQUIRE(m.largest_free_run() == 96);
+  m.deallocate(b, 16, 4);
+  REQUIRE(m.bytes_in_use() == 80 + 32);
+  SECTION("for_each_chunk")
+  {
+    std::vector<void *> chunks;
+    std::vector<std::size_t> counts;
+    m.for_each_chunk([&](void * chunk, bitset<8> const & marker) {
+      chunks.push_back(chunk);
+      counts.push_back(marker.count());
+    });
+    REQUIRE(chunks.size() == 2);
+    REQUIRE(std::less<void *>()(chunks[0], chunks[1]));
+    REQUIRE(counts[0] + counts[1] == 7);
+    REQUIRE(m[c] == (counts[0] == 2 ? chunks[0] : chunks[1]));
+  }
+}
 TEST_CASE("traits", "[traits]")
 {
   REQUIRE(is_owner_v<free_block<128, 4, 2, stack<4>, heap>> == true);
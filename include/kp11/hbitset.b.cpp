@@ -0,0 +1,44 @@
+#include "hbitset.h"
+
+#include "bitset.h" // bitset
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef> // size_t
+
+using namespace kp11;
+
+// The markers are filled so that the only free indexes are at the very end, which is the worst case
+// for a first fit search.
+
+template<typename Marker>
+static void hbitset_allocate_one(benchmark::State & state)
+{
+  Marker m;
+  m.allocate(m.size());
+  for (auto _ : state)
+  {
+    m.deallocate(m.size() - 1, 1);
+    benchmark::DoNotOptimize(m.allocate(1));
+  }
+}
+BENCHMARK_TEMPLATE(hbitset_allocate_one, bitset<1 << 12>);
+BENCHMARK_TEMPLATE(hbitset_allocate_one, hbitset<1 << 12>);
+BENCHMARK_TEMPLATE(hbitset_allocate_one, bitset<1 << 18>);
+BENCHMARK_TEMPLATE(hbitset_allocate_one, hbitset<1 << 18>);
+
+template<typename Marker>
+static void hbitset_allocate_many(benchmark::State & state)
+{
+  Marker m;
+  m.allocate(m.size());
+  for (auto _ : state)
+  {
+    m.deallocate(m.size() - 8, 8);
+    benchmark::DoNotOptimize(m.allocate(8));
+  }
+}
+BENCHMARK_TEMPLATE(hbitset_allocate_many, bitset<1 << 12>);
+BENCHMARK_TEMPLATE(hbitset_allocate_many, hbitset<1 << 12>);
+BENCHMARK_TEMPLATE(hbitset_allocate_many, bitset<1 << 18>);
+BENCHMARK_TEMPLATE(hbitset_allocate_many, hbitset<1 << 18>);
\ No newline at end of file
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "detail/bit.h" // word, word_bits, countr_zero, countl_zero, mask, find_runs, longest_zero_run
+
+#include <array> // array
+#include <cassert> // assert
+#include <cstddef> // size_t
+
+namespace kp11
+{
+  /// @brief First fit. Searches a bitset through a hierarchy of summary words.
+  ///
+  /// Indexes are stored as a bitset of 64-bit leaf words, where each bit corresponds to an index.
+  /// A summary bitset has a bit for every leaf word that still has unallocated indexes, and a top
+  /// bitset has a bit for every summary word that isn't empty. Searches only visit the words that
+  /// can satisfy them so full parts of the bitset are skipped 4096 indexes at a time.
+  ///
+  /// @tparam N Total number of indexes
+  template<std::size_t N>
+  class hbitset
+  {
+  public: // typedefs
+    /// Size type.
+    using size_type = std::size_t;
+
+  private: // typedefs
+    using word = detail::word;
+
+  private: // constants
+    static constexpr size_type word_bits = detail::word_bits;
+    static constexpr size_type num_words(size_type n) noexcept
+    {
+      return n / word_bits + (n % word_bits != 0);
+    }
+    static constexpr size_type num_leaves = num_words(N);
+    static constexpr size_type num_summaries = num_words(num_leaves);
+    static constexpr size_type num_tops = num_words(num_summaries);
+    /// Number of bits in the last leaf word that are past `N`.
+    static constexpr size_type num_padding = num_leaves * word_bits - N;
+
+  public: // constructors
+    hbitset() noexcept
+    {
+      // Bits past `N` are permanently allocated so that searches never have to check for them.
+      if constexpr (num_padding != 0)
+      {
+        leaves[num_leaves - 1] = ~word(0) << (word_bits - num_padding);
+      }
+      for (size_type k = 0; k != num_leaves; ++k)
+      {
+        summaries[k / word_bits] |= word(1) << (k % word_bits);
+      }
+      for (size_type s = 0; s != num_summaries; ++s)
+      {
+        tops[s / word_bits] |= word(1) << (s % word_bits);
+      }
+    }
+
+  public: // capacity
+    /// @returns Number of allocated indexes.
+    size_type count() const noexcept
+    {
+      return num_allocated;
+    }
+    /// @returns Total number of indexes (`N`).
+    static constexpr size_type size() noexcept
+    {
+      return N;
+    }
+    /// @returns The maximum allocation size supported.
+    static constexpr size_type max_size() noexcept
+    {
+      return size();
+    }
+    /// @returns Largest `n` that `allocate(n)` would currently succeed with, which is the length of
+    /// the longest run of unallocated indexes.
+    /// * Complexity `O(N / 64)`
+    size_type largest_free_run() const noexcept
+    {
+      return detail::longest_zero_run(leaves.begin(), leaves.end());
+    }
+
+  public: // modifiers
+    /// Walk down the summary hierarchy to the first leaf word with unallocated indexes and search
+    /// from there. The algorithms for `n==1` and `n!=1` are different.
+    /// * Complexity `O(N / 2^18)` for `n == 1`, `O(N / 64)` for `n > 1`.
+    ///
+    /// @param n Number of indexes to allocate.
+    ///
+    /// @returns (success) Index of the start of the `n` indexes allocated.
+    /// @returns (failure) `size()`
+    ///
+    /// @pre `n > 0`
+    /// @pre `n <= max_size()`
+    ///
+    /// @post [`(return value)`, `(return value) + n`) will not returned again from any subsequent
+    /// call to `allocate` unless it has been `deallocate`d.
+    /// @post `count() == (previous) count() + n`.
+    size_type allocate(size_type n) noexcept
+    {
+      assert(n > 0);
+      assert(n <= max_size());
+      return n == 1 ? allocate_one() : allocate_many(n);
+    }
+    /// Reset the bits from `i` to `i + n` a word at a time and mark their words as having
+    /// unallocated indexes.
+    /// * Complexity `O(n / 64)`
+    ///
+    /// @param i Return value of a call to `allocate` that isn't `size()`.
+    /// @param n Corresponding parameter in the call to `allocate`.
+    ///
+    /// @post [`i`, `i + n`) may be returned by a call to `allocate`.
+    /// @post `count() == (previous) count() - n`
+    void deallocate(size_type i, size_type n) noexcept
+    {
+      assert(n <= size());
+      assert(i < size());
+      assert(i + n <= size());
+      assign(i, n, false);
+      num_allocated -= n;
+    }
+
+  private: // helper functions
+    /// The first non-full leaf word is found through the summaries and then the lowest unallocated
+    /// bit is found by counting trailing ones.
+    size_type allocate_one() noexcept
+    {
+      for (size_type t = 0; t != num_tops; ++t)
+      {
+        if (auto const top = tops[t])
+        {
+          auto const s = t * word_bits + detail::countr_zero(top);
+          auto const k = s * word_bits + detail::countr_zero(summaries[s]);
+          auto const i = k * word_bits + detail::countr_zero(~leaves[k]);
+          ++num_allocated;
+          return claim(i, 1);
+        }
+      }
+      return size();
+    }
+    /// Same as `bitset` except that only leaf words with unallocated bits are visited. A run
+    /// carried over from previous words is broken by every skipped (full) word.
+    size_type allocate_many(size_type n) noexcept
+    {
+      assert(n > 1);
+      // Number of unallocated bits at the end of the previous visited word.
+      size_type run = 0;
+      // Index of the next leaf word that would continue the carried run.
+      size_type next = 0;
+      for (size_type t = 0; t != num_tops; ++t)
+      {
+        for (auto top = tops[t]; top; top &= top - 1)
+        {
+          auto const s = t * word_bits + detail::countr_zero(top);
+          for (auto summary = summaries[s]; summary; summary &= summary - 1)
+          {
+            auto const k = s * word_bits + detail::countr_zero(summary);
+            auto const w = leaves[k];
+            if (k != next)
+            {
+              run = 0;
+            }
+            next = k + 1;
+            // The carried run continues up to the first allocated bit in this word.
+            if (run + detail::countr_zero(w) >= n)
+            {
+              num_allocated += n;
+              return claim(k * word_bits - run, n);
+            }
+            if (w == 0)
+            {
+              run += word_bits;
+              continue;
+            }
+            if (n <= word_bits)
+            {
+              if (auto const starts = detail::find_runs(~w, n))
+              {
+                num_allocated += n;
+                return claim(k * word_bits + detail::countr_zero(starts), n);
+              }
+            }
+            run = detail::countl_zero(w);
+          }
+        }
+      }
+      return size();
+    }
+    /// Allocate [`i`, `i + n`).
+    ///
+    /// @returns `i`
+    size_type claim(size_type i, size_type n) noexcept
+    {
+      assign(i, n, true);
+      return i;
+    }
+    /// Set or reset the bits [`i`, `i + n`) one word at a time and keep the summaries up to date.
+    void assign(size_type i, size_type n, bool value) noexcept
+    {
+      for (auto last = i + n; i != last;)
+      {
+        auto const k = i / word_bits;
+        auto const b = i % word_bits;
+        auto const m = last - i < word_bits - b ? last - i : word_bits - b;
+        auto const bits = detail::mask(b, m);
+        if (value)
+        {
+          assert((leaves[k] & bits) == 0);
+          if ((leaves[k] |= bits) == ~word(0))
+          {
+            set_full(k);
+          }
+        }
+        else
+        {
+          assert((leaves[k] & bits) == bits);
+          if (leaves[k] == ~word(0))
+          {
+            reset_full(k);
+          }
+          leaves[k] &= ~bits;
+        }
+        i += m;
+      }
+    }
+    /// Leaf word `k` has no more unallocated bits.
+    void set_full(size_type k) noexcept
+    {
+      auto const s = k / word_bits;
+      if ((summaries[s] &= ~(word(1) << (k % word_bits))) == 0)
+      {
+        tops[s / word_bits] &= ~(word(1) << (s % word_bits));
+      }
+    }
+    /// Leaf word `k` is about to have unallocated bits.
+    void reset_full(size_type k) noexcept
+    {
+      auto const s = k / word_bits;
+      summaries[s] |= word(1) << (k % word_bits);
+      tops[s / word_bits] |= word(1) << (s % word_bits);
+    }
+
+  private: // variables
+    size_type num_allocated = 0;
+    /// Bit `k % 64` of word `k / 64` is `1` if `summaries[k]` is not `0`.
+    std::array<word, num_tops> tops = {};
+    /// Bit `k % 64` of word `k / 64` is `1` if `leaves[k]` has unallocated bits.
+    std::array<word, num_summaries> summaries = {};
+    /// `1` if allocated, `0` if not allocated. Index `i` is bit `i % 64` of word `i / 64`.
+    std::array<word, num_leaves> leaves = {};
+  };
+}
\ No newline at end of file
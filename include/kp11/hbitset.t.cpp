@@ -0,0 +1,139 @@
+#include "hbitset.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "traits.h" // is_marker_v
+
+#include <catch.hpp>
+
+using namespace kp11;
+
+TEST_CASE("size", "[size]")
+{
+  SECTION("1")
+  {
+    hbitset<10> m;
+    REQUIRE(m.size() == 10);
+    REQUIRE(m.max_size() == 10);
+    REQUIRE(m.count() == 0);
+  }
+  SECTION("2")
+  {
+    hbitset<1 << 18> m;
+    REQUIRE(m.size() == 1 << 18);
+    REQUIRE(m.max_size() == 1 << 18);
+    REQUIRE(m.count() == 0);
+  }
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  hbitset<10> m;
+  SECTION("allocate 1")
+  {
+    auto a = m.allocate(1);
+    REQUIRE(a == 0);
+    REQUIRE(m.count() == 1);
+    SECTION("post condition")
+    {
+      auto b = m.allocate(1);
+      REQUIRE(b == 1);
+      REQUIRE(m.count() == 2);
+    }
+  }
+  SECTION("allocate many")
+  {
+    auto a = m.allocate(5);
+    REQUIRE(a == 0);
+    REQUIRE(m.count() == 5);
+    SECTION("post condition")
+    {
+      auto b = m.allocate(5);
+      REQUIRE(b == 5);
+      REQUIRE(m.count() == 10);
+    }
+  }
+  SECTION("failure")
+  {
+    m.allocate(10);
+    SECTION("one")
+    {
+      REQUIRE(m.allocate(1) == m.size());
+    }
+    SECTION("many")
+    {
+      REQUIRE(m.allocate(5) == m.size());
+    }
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  hbitset<10> m;
+  auto a = m.allocate(5);
+  SECTION("recovers indexes")
+  {
+    m.deallocate(a, 5);
+    REQUIRE(m.count() == 0);
+    auto b = m.allocate(10);
+    REQUIRE(b == a);
+  }
+}
+TEST_CASE("summaries", "[summaries]")
+{
+  hbitset<(1 << 18) + 100> m;
+  SECTION("allocate 1 skips full words")
+  {
+    REQUIRE(m.allocate(1 << 18) == 0);
+    REQUIRE(m.allocate(1) == 1 << 18);
+    m.deallocate(4097, 1);
+    REQUIRE(m.allocate(1) == 4097);
+    REQUIRE(m.count() == (1 << 18) + 1);
+  }
+  SECTION("allocate many skips full words")
+  {
+    REQUIRE(m.allocate(1 << 18) == 0);
+    m.deallocate(100, 10);
+    m.deallocate(130000, 70);
+    REQUIRE(m.allocate(11) == 130000);
+    REQUIRE(m.allocate(59) == 130011);
+    REQUIRE(m.allocate(10) == 100);
+    REQUIRE(m.allocate(101) == m.size());
+    REQUIRE(m.allocate(100) == 1 << 18);
+    REQUIRE(m.count() == m.size());
+  }
+  SECTION("a run is broken by a full word")
+  {
+    REQUIRE(m.allocate(1 << 18) == 0);
+    m.deallocate(60, 4);
+    m.deallocate(128, 4);
+    REQUIRE(m.allocate(8) == 1 << 18);
+  }
+}
+TEST_CASE("free_block", "[free_block]")
+{
+  free_block<(1 << 18) * 8, 8, 1, hbitset<1 << 18>, heap> m;
+  auto a = m.allocate(8, 8);
+  REQUIRE(a != nullptr);
+  REQUIRE(m.deallocate(a, 8, 8) == true);
+}
+TEST_CASE("largest_free_run", "[largest_free_run]")
+{
+  hbitset<130> m;
+  REQUIRE(m.largest_free_run() == 130);
+  auto a = m.allocate(10);
+  auto b = m.allocate(60);
+  m.allocate(1);
+  REQUIRE(m.largest_free_run() == 59);
+  m.deallocate(b, 60);
+  REQUIRE(m.largest_free_run() == 60);
+  m.deallocate(a, 10);
+  REQUIRE(m.largest_free_run() == 70);
+  m.allocate(70);
+  REQUIRE(m.largest_free_run() == 59);
+  m.allocate(59);
+  REQUIRE(m.largest_free_run() == 0);
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_marker_v<hbitset<10>> == true);
+  REQUIRE(is_marker_v<hbitset<1 << 18>> == true);
+}
\ No newline at end of file
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "traits.h" // allocation_result
+
 #include <cstddef> // size_t
 #include <limits> // numeric_limits
 
 namespace kp11
 {
   /// Call `new` on `allocate` and `delete` on `deallocate`.
+  ///
+  /// Sizes are rounded up to a multiple of the alignment, or of `__STDCPP_DEFAULT_NEW_ALIGNMENT__`
+  /// if that is larger, before they are passed to `new` and `delete`. `new` can't return any less
+  /// than that anyway, so `allocate_at_least` can report the rounded size as usable.
   class heap
   {
   public: // typedefs
@@ -32,6 +38,16 @@ namespace kp11
     ///
     /// @post (success) `(return value)` will not be returned again until it has been `deallocated`.
     pointer allocate(size_type size, size_type alignment) noexcept;
+    /// Same as `allocate` but also returns the usable size, which is `size` rounded up to a
+    /// multiple of the alignment.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block and its usable size.
+    /// @returns (failure) `nullptr` and `0`.
+    allocation_result<pointer, size_type> allocate_at_least(
+      size_type size, size_type alignment) noexcept;
     /// Deallocate memory by calling `delete`.
     ///
     /// @param ptr Pointer return by a call to `allocate`.
@@ -24,6 +24,18 @@ TEST_CASE("allocate/deallocate", "[allocate/deallocate]")
   m.deallocate(a, 32, 4);
   m.deallocate(b, 64, 8);
 }
+TEST_CASE("allocate_at_least", "[allocate/deallocate]")
+{
+  heap m;
+  auto a = m.allocate_at_least(100, 64);
+  REQUIRE(a.ptr != nullptr);
+  REQUIRE(a.count == 128);
+  auto b = m.allocate_at_least(1, 1);
+  REQUIRE(b.ptr != nullptr);
+  REQUIRE(b.count == __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  m.deallocate(a.ptr, a.count, 64);
+  m.deallocate(b.ptr, 1, 1);
+}
 TEST_CASE("traits", "[traits]")
 {
   REQUIRE(is_resource_v<heap> == true);
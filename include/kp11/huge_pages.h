@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cassert> // assert
+#include <cstddef> // size_t, byte
+#include <cstdint> // uintptr_t
+#include <cstdio> // FILE, fopen, fgets, sscanf, fclose
+#include <cstring> // strstr
+#include <limits> // numeric_limits
+
+#include <sys/mman.h> // mmap, munmap, madvise, PROT_READ, PROT_WRITE, MAP_PRIVATE, MAP_ANONYMOUS, MAP_HUGETLB, MAP_FAILED, MADV_HUGEPAGE
+
+namespace kp11
+{
+  /// Kinds of pages backing memory allocated by `huge_pages`.
+  enum class page_kind
+  {
+    /// Ordinary pages.
+    small,
+    /// Transparent huge pages were requested with `madvise(MADV_HUGEPAGE)`. The kernel backs the
+    /// memory with huge pages when it can, which may be after it is first touched.
+    transparent,
+    /// Huge pages reserved with `hugetlbfs`, requested with `MAP_HUGETLB`.
+    hugetlb
+  };
+
+  /// @brief Allocate `HugePageSize` aligned memory that is backed by huge pages when they are
+  /// available, to reduce TLB misses in large chunks.
+  ///
+  /// Each allocation is rounded up to a whole number of huge pages and mapped on its own.
+  /// Transparent huge pages are requested, or ordinary pages are used if transparent huge pages
+  /// are disabled. The kind that was used is reported by `last_kind` and `count`. Use it as the
+  /// `Upstream` of `free_block` or `monotonic` with a `ChunkSize` and `ChunkAlignment` of
+  /// `HugePageSize`.
+  ///
+  /// @tparam HugePageSize Size in bytes of a huge page.
+  /// @tparam UseHugetlb Try reserved `hugetlbfs` pages before transparent huge pages. They are only
+  /// tried if the system's default huge page size is `HugePageSize`, so most systems, which have
+  /// none reserved, don't pay for a failing `mmap` on every allocation by default.
+  template<std::size_t HugePageSize = 2 * 1024 * 1024, bool UseHugetlb = false>
+  class huge_pages
+  {
+    static_assert((HugePageSize & (HugePageSize - 1)) == 0);
+
+  public: // typedefs
+    /// Pointer type.
+    using pointer = void *;
+    /// Size type.
+    using size_type = std::size_t;
+
+  public: // constants
+    /// Size in bytes of a huge page.
+    static constexpr auto huge_page_size = HugePageSize;
+
+  public: // capacity
+    /// @returns The maximum allocation size supported.
+    static constexpr size_type max_size() noexcept
+    {
+      return std::numeric_limits<size_type>::max() / huge_page_size * huge_page_size -
+             huge_page_size;
+    }
+
+  public: // modifiers
+    /// Map whole huge pages for `size`, preferring reserved huge pages if `UseHugetlb`, then
+    /// transparent huge pages and then ordinary pages.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment in bytes of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block, aligned to
+    /// `huge_page_size`.
+    /// @returns (failure) `nullptr`
+    ///
+    /// @pre `huge_page_size % alignment == 0`
+    /// @pre `size <= max_size()`
+    pointer allocate(size_type size, [[maybe_unused]] size_type alignment) noexcept
+    {
+      assert(huge_page_size % alignment == 0);
+      assert(size <= max_size());
+      size = round_up(size);
+      if constexpr (UseHugetlb)
+      {
+        if (hugetlb_available())
+        {
+          if (auto ptr = map_hugetlb(size))
+          {
+            return found(ptr, page_kind::hugetlb);
+          }
+        }
+      }
+      auto ptr = map_aligned(size);
+      if (!ptr)
+      {
+        return nullptr;
+      }
+      if (transparent_available() && ::madvise(ptr, size, MADV_HUGEPAGE) == 0)
+      {
+        return found(ptr, page_kind::transparent);
+      }
+      return found(ptr, page_kind::small);
+    }
+    /// Unmap the memory.
+    ///
+    /// @param ptr Pointer returned by a call to `allocate`.
+    /// @param size Corresponding parameter used in `allocate`.
+    /// @param alignment Corresponding parameter used in `allocate`.
+    void deallocate(pointer ptr, size_type size, size_type) noexcept
+    {
+      ::munmap(ptr, round_up(size));
+    }
+
+  public: // observers
+    /// @returns Kind of pages backing the most recent successful allocation. `page_kind::small`
+    /// if there hasn't been one.
+    page_kind last_kind() const noexcept
+    {
+      return last;
+    }
+    /// @returns Number of successful allocations that were backed by `kind` pages.
+    std::size_t count(page_kind kind) const noexcept
+    {
+      return counts[static_cast<std::size_t>(kind)];
+    }
+    /// @returns `true` if transparent huge pages aren't disabled system wide.
+    static bool transparent_available() noexcept
+    {
+      static bool const available = [] {
+        auto file = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+        if (!file)
+        {
+          return false;
+        }
+        char line[128] = {};
+        auto read = std::fgets(line, sizeof(line), file) != nullptr;
+        std::fclose(file);
+        return read && !std::strstr(line, "[never]");
+      }();
+      return available;
+    }
+    /// @returns `true` if the default size of reserved huge pages is `huge_page_size`, so that
+    /// they can be requested with `MAP_HUGETLB` and unmapped with the same length.
+    static bool hugetlb_available() noexcept
+    {
+      static bool const available = [] {
+        auto file = std::fopen("/proc/meminfo", "r");
+        if (!file)
+        {
+          return false;
+        }
+        char line[128] = {};
+        unsigned long long kb = 0;
+        while (std::fgets(line, sizeof(line), file) &&
+               std::sscanf(line, "Hugepagesize: %llu kB", &kb) != 1)
+        {
+        }
+        std::fclose(file);
+        return kb * 1024 == huge_page_size;
+      }();
+      return available;
+    }
+
+  private: // helpers
+    static size_type round_up(size_type size) noexcept
+    {
+      return ((size == 0) + size / huge_page_size + (size % huge_page_size != 0)) * huge_page_size;
+    }
+    /// @returns (success) Memory backed by reserved huge pages.
+    /// @returns (failure) `nullptr`
+    static std::byte * map_hugetlb([[maybe_unused]] size_type size) noexcept
+    {
+#if defined(MAP_HUGETLB)
+      // Only the default huge page size can be requested without encoding it in the flags.
+      if (auto ptr = ::mmap(nullptr,
+            size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+            -1,
+            0);
+          ptr != MAP_FAILED)
+      {
+        if (reinterpret_cast<std::uintptr_t>(ptr) % huge_page_size == 0)
+        {
+          return static_cast<std::byte *>(ptr);
+        }
+        ::munmap(ptr, size);
+      }
+#endif
+      return nullptr;
+    }
+    /// Over allocate by a huge page and unmap the ends so that the memory is aligned to a huge
+    /// page, which is required for the kernel to back it with huge pages.
+    ///
+    /// @returns (success) Memory aligned to `huge_page_size`.
+    /// @returns (failure) `nullptr`
+    static std::byte * map_aligned(size_type size) noexcept
+    {
+      auto ptr = ::mmap(
+        nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (ptr == MAP_FAILED)
+      {
+        return nullptr;
+      }
+      auto first = static_cast<std::byte *>(ptr);
+      auto const misalignment = reinterpret_cast<std::uintptr_t>(first) % huge_page_size;
+      auto const head = misalignment == 0 ? 0 : huge_page_size - misalignment;
+      if (head != 0)
+      {
+        ::munmap(first, head);
+      }
+      ::munmap(first + head + size, huge_page_size - head);
+      return first + head;
+    }
+    pointer found(std::byte * ptr, page_kind kind) noexcept
+    {
+      last = kind;
+      ++counts[static_cast<std::size_t>(kind)];
+      return ptr;
+    }
+
+  private: // variables
+    page_kind last = page_kind::small;
+    std::size_t counts[3] = {};
+  };
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "huge_pages.h"
+
+#include "bitset.h" // bitset
+#include "free_block.h" // free_block, dynamic_chunks
+#include "pool.h" // pool
+#include "traits.h" // is_resource_v
+
+#include <catch.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <cstring> // memset
+
+using namespace kp11;
+
+namespace
+{
+  constexpr std::size_t huge = 2 * 1024 * 1024;
+}
+
+TEST_CASE("allocate/deallocate", "[allocate/deallocate]")
+{
+  huge_pages<> m;
+  auto a = m.allocate(100, 16);
+  REQUIRE(a != nullptr);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(a) % huge == 0);
+  std::memset(a, 1, huge);
+  auto b = m.allocate(huge + 1, huge);
+  REQUIRE(b != nullptr);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(b) % huge == 0);
+  std::memset(b, 1, 2 * huge);
+  REQUIRE(m.count(page_kind::small) + m.count(page_kind::transparent) +
+            m.count(page_kind::hugetlb) ==
+          2);
+  if (!huge_pages<>::transparent_available())
+  {
+    REQUIRE(m.count(page_kind::transparent) == 0);
+  }
+  REQUIRE(m.count(m.last_kind()) != 0);
+  REQUIRE(m.count(page_kind::hugetlb) == 0);
+  m.deallocate(a, 100, 16);
+  m.deallocate(b, huge + 1, huge);
+}
+TEST_CASE("hugetlb", "[allocate/deallocate]")
+{
+  huge_pages<huge, true> m;
+  auto a = m.allocate(100, 16);
+  REQUIRE(a != nullptr);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(a) % huge == 0);
+  std::memset(a, 1, huge);
+  if (!huge_pages<huge, true>::hugetlb_available())
+  {
+    REQUIRE(m.count(page_kind::hugetlb) == 0);
+  }
+  m.deallocate(a, 100, 16);
+}
+TEST_CASE("upstream", "[upstream]")
+{
+  free_block<huge, 4096, 2, bitset<512>, huge_pages<>> m;
+  auto a = m.allocate(4096, 4096);
+  REQUIRE(a != nullptr);
+  REQUIRE(m.get_upstream().count(m.get_upstream().last_kind()) == 1);
+  m.deallocate(a, 4096, 4096);
+}
+TEST_CASE("dynamic_chunks", "[upstream]")
+{
+  // The index of chunks isn't allocated from upstream, so every mapping is a chunk.
+  free_block<huge, huge, dynamic_chunks, pool<1>, huge_pages<>> m;
+  for (int i = 0; i < 5; ++i)
+  {
+    REQUIRE(m.allocate(huge, huge) != nullptr);
+  }
+  auto const & u = m.get_upstream();
+  REQUIRE(u.count(page_kind::small) + u.count(page_kind::transparent) +
+            u.count(page_kind::hugetlb) ==
+          5);
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_resource_v<huge_pages<>> == true);
+}
\ No newline at end of file
@@ -77,6 +77,18 @@ namespace kp11
     {
       return size();
     }
+    /// @returns Largest `n` that `allocate(n)` would currently succeed with, which is the size of
+    /// the largest unallocated run.
+    /// * Complexity `O(n)`
+    size_type largest_free_run() const noexcept
+    {
+      size_type n = 0;
+      for (size_type i = 0; i != size(); i += runs[i].size)
+      {
+        n = runs[i].available > n ? runs[i].available : n;
+      }
+      return n;
+    }
 
   public: // modifiers
     /// Forward iterate through the runs to find the first unallocated run for `n`. If there are
@@ -140,6 +152,72 @@ namespace kp11
       }
       set_run(i, n, n);
     }
+    /// Grow the run [`i`, `i + old_n`) to [`i`, `i + new_n`) by taking the front of the
+    /// unallocated run right after it, if there is one with enough indexes.
+    /// * Complexity `O(1)`
+    ///
+    /// @param i Returned by a call to `allocate`.
+    /// @param old_n Corresponding parameter in the call to `allocate`.
+    /// @param new_n Number of indexes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    ///
+    /// @pre `0 < old_n <= new_n`
+    bool expand(size_type i, size_type old_n, size_type new_n) noexcept
+    {
+      assert(0 < old_n && old_n <= new_n);
+      assert(i + old_n <= size());
+      assert(runs[i].available == 0);
+      assert(runs[i].size == old_n);
+      if (old_n == new_n)
+      {
+        return true;
+      }
+      auto const next = static_cast<size_type>(i + old_n);
+      auto const extra = static_cast<size_type>(new_n - old_n);
+      if (next == size() || runs[next].available < extra)
+      {
+        return false;
+      }
+      if (auto const m = static_cast<size_type>(runs[next].size - extra))
+      {
+        set_run(static_cast<size_type>(next + extra), m, m);
+      }
+      set_run(i, new_n, 0);
+      return true;
+    }
+    /// Shrink the run [`i`, `i + old_n`) to [`i`, `i + new_n`). The indexes given up are merged
+    /// with the unallocated run right after it if there is one.
+    /// * Complexity `O(1)`
+    ///
+    /// @param i Returned by a call to `allocate`.
+    /// @param old_n Corresponding parameter in the call to `allocate`.
+    /// @param new_n Number of indexes wanted.
+    ///
+    /// @returns `true`
+    ///
+    /// @pre `0 < new_n <= old_n`
+    bool shrink(size_type i, size_type old_n, size_type new_n) noexcept
+    {
+      assert(0 < new_n && new_n <= old_n);
+      assert(i + old_n <= size());
+      assert(runs[i].available == 0);
+      assert(runs[i].size == old_n);
+      if (old_n == new_n)
+      {
+        return true;
+      }
+      auto n = static_cast<size_type>(old_n - new_n);
+      if (auto const next = static_cast<size_type>(i + old_n);
+          next < size() && runs[next].available)
+      {
+        n += runs[next].size;
+      }
+      set_run(i, new_n, 0);
+      set_run(static_cast<size_type>(i + new_n), n, n);
+      return true;
+    }
 
   private: // helpers
     /// Exists because both the start and end of the run must be set.
@@ -212,6 +212,44 @@ TEST_CASE("max separate", "[max_separate]")
   m.deallocate(k, 1);
   REQUIRE(m.count() == 5);
 }
+TEST_CASE("largest_free_run", "[largest_free_run]")
+{
+  list<10> m;
+  REQUIRE(m.largest_free_run() == 10);
+  auto a = m.allocate(3);
+  auto b = m.allocate(2);
+  m.allocate(1);
+  REQUIRE(m.largest_free_run() == 4);
+  m.deallocate(b, 2);
+  REQUIRE(m.largest_free_run() == 4);
+  m.deallocate(a, 3);
+  REQUIRE(m.largest_free_run() == 5);
+  m.allocate(4);
+  m.allocate(5);
+  REQUIRE(m.largest_free_run() == 0);
+}
+TEST_CASE("expand/shrink", "[expand/shrink]")
+{
+  list<10> m;
+  auto a = m.allocate(3);
+  auto b = m.allocate(2);
+  REQUIRE(a == 7);
+  REQUIRE(b == 5);
+  REQUIRE(m.expand(b, 2, 3) == false);
+  m.deallocate(a, 3);
+  REQUIRE(m.expand(b, 2, 4) == true);
+  REQUIRE(m.count() == 4);
+  REQUIRE(m.largest_free_run() == 5);
+  REQUIRE(m.expand(b, 4, 6) == false);
+  REQUIRE(m.expand(b, 4, 5) == true);
+  REQUIRE(m.count() == 5);
+  REQUIRE(m.shrink(b, 5, 1) == true);
+  REQUIRE(m.count() == 1);
+  REQUIRE(m.largest_free_run() == 5);
+  m.deallocate(b, 1);
+  REQUIRE(m.count() == 0);
+  REQUIRE(m.largest_free_run() == 10);
+}
 TEST_CASE("traits", "[traits]")
 {
   REQUIRE(is_marker_v<list<10>> == true);
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "traits.h" // is_strategy_v
+#include "traits.h" // is_strategy_v, allocation_result
 
 #include <cassert> // assert
 #include <cstddef> // size_t, byte
@@ -64,6 +64,25 @@ namespace kp11
       }
       return nullptr;
     }
+    /// Same as `allocate` but also returns the usable size, which is the whole buffer.
+    /// * Complexity `O(1)`
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of our buffer and `Size`.
+    /// @returns (failure) `nullptr` and `0`.
+    ///
+    /// @pre `Alignment % alignment == 0`
+    allocation_result<pointer, size_type> allocate_at_least(
+      size_type size, size_type alignment) noexcept
+    {
+      if (auto ptr = allocate(size, alignment))
+      {
+        return {ptr, Size};
+      }
+      return {nullptr, 0};
+    }
     /// If `ptr` points to the beginning of our buffer then we can allocate our buffer again.
     /// * Complexity `O(1)`
     ///
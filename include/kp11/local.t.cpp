@@ -19,6 +19,17 @@ TEST_CASE("allocate", "[allocate]")
   auto b = m.allocate(32, 4);
   REQUIRE(b == nullptr);
 }
+TEST_CASE("allocate_at_least", "[allocate]")
+{
+  local<128, 4> m;
+  auto a = m.allocate_at_least(32, 4);
+  REQUIRE(a.ptr != nullptr);
+  REQUIRE(a.count == 128);
+  auto b = m.allocate_at_least(32, 4);
+  REQUIRE(b.ptr == nullptr);
+  REQUIRE(b.count == 0);
+  REQUIRE(m.deallocate(a.ptr, a.count, 4) == true);
+}
 TEST_CASE("deallocate", "[deallocate]")
 {
   local<128, 4> m;
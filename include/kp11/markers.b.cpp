@@ -0,0 +1,189 @@
+#include "bitset.h" // bitset
+#include "hbitset.h" // hbitset
+#include "list.h" // list
+#include "pool.h" // pool
+#include "segregated_list.h" // segregated_list
+#include "stack.h" // stack
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // shuffle
+#include <cstddef> // size_t
+#include <cstdint> // int64_t
+#include <memory> // make_unique
+#include <new> // new
+#include <random> // mt19937
+#include <vector> // vector
+
+using namespace kp11;
+
+// Allocation patterns shared by every marker. Each iteration of a batch pattern allocates every
+// index of the marker one at a time and then deallocates them in the order given by the pattern.
+
+namespace
+{
+  template<typename Marker>
+  using index_t = typename Marker::size_type;
+
+  template<typename Marker>
+  std::vector<index_t<Marker>> allocate_all(Marker & m)
+  {
+    std::vector<index_t<Marker>> indexes;
+    indexes.reserve(static_cast<std::size_t>(m.size()));
+    for (std::size_t i = 0; i != static_cast<std::size_t>(m.size()); ++i)
+    {
+      indexes.push_back(m.allocate(1));
+    }
+    return indexes;
+  }
+}
+
+template<typename Marker>
+static void marker_pair(benchmark::State & state)
+{
+  auto m = std::make_unique<Marker>();
+  for (auto _ : state)
+  {
+    auto i = m->allocate(1);
+    benchmark::DoNotOptimize(i);
+    m->deallocate(i, 1);
+  }
+}
+BENCHMARK_TEMPLATE(marker_pair, pool<255>);
+BENCHMARK_TEMPLATE(marker_pair, stack<255>);
+BENCHMARK_TEMPLATE(marker_pair, list<255>);
+BENCHMARK_TEMPLATE(marker_pair, bitset<255>);
+BENCHMARK_TEMPLATE(marker_pair, hbitset<255>);
+BENCHMARK_TEMPLATE(marker_pair, segregated_list<255>);
+
+template<typename Marker>
+static void marker_lifo(benchmark::State & state)
+{
+  auto m = std::make_unique<Marker>();
+  for (auto _ : state)
+  {
+    auto indexes = allocate_all(*m);
+    for (auto it = indexes.rbegin(); it != indexes.rend(); ++it)
+    {
+      m->deallocate(*it, 1);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(m->size()));
+}
+BENCHMARK_TEMPLATE(marker_lifo, pool<255>);
+BENCHMARK_TEMPLATE(marker_lifo, stack<255>);
+BENCHMARK_TEMPLATE(marker_lifo, list<255>);
+BENCHMARK_TEMPLATE(marker_lifo, bitset<255>);
+BENCHMARK_TEMPLATE(marker_lifo, hbitset<255>);
+BENCHMARK_TEMPLATE(marker_lifo, segregated_list<255>);
+BENCHMARK_TEMPLATE(marker_lifo, pool<4096>);
+BENCHMARK_TEMPLATE(marker_lifo, bitset<4096>);
+BENCHMARK_TEMPLATE(marker_lifo, hbitset<4096>);
+BENCHMARK_TEMPLATE(marker_lifo, segregated_list<4096>);
+
+// `stack` only recovers the most recently allocated indexes so it isn't benchmarked with the other
+// orders.
+template<typename Marker>
+static void marker_fifo(benchmark::State & state)
+{
+  auto m = std::make_unique<Marker>();
+  for (auto _ : state)
+  {
+    for (auto i : allocate_all(*m))
+    {
+      m->deallocate(i, 1);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(m->size()));
+}
+BENCHMARK_TEMPLATE(marker_fifo, pool<255>);
+BENCHMARK_TEMPLATE(marker_fifo, list<255>);
+BENCHMARK_TEMPLATE(marker_fifo, bitset<255>);
+BENCHMARK_TEMPLATE(marker_fifo, hbitset<255>);
+BENCHMARK_TEMPLATE(marker_fifo, segregated_list<255>);
+BENCHMARK_TEMPLATE(marker_fifo, pool<4096>);
+BENCHMARK_TEMPLATE(marker_fifo, bitset<4096>);
+BENCHMARK_TEMPLATE(marker_fifo, hbitset<4096>);
+BENCHMARK_TEMPLATE(marker_fifo, segregated_list<4096>);
+
+template<typename Marker>
+static void marker_random(benchmark::State & state)
+{
+  auto m = std::make_unique<Marker>();
+  std::mt19937 rng;
+  for (auto _ : state)
+  {
+    auto indexes = allocate_all(*m);
+    state.PauseTiming();
+    std::shuffle(indexes.begin(), indexes.end(), rng);
+    state.ResumeTiming();
+    for (auto i : indexes)
+    {
+      m->deallocate(i, 1);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(m->size()));
+}
+BENCHMARK_TEMPLATE(marker_random, pool<255>);
+BENCHMARK_TEMPLATE(marker_random, list<255>);
+BENCHMARK_TEMPLATE(marker_random, bitset<255>);
+BENCHMARK_TEMPLATE(marker_random, hbitset<255>);
+BENCHMARK_TEMPLATE(marker_random, segregated_list<255>);
+BENCHMARK_TEMPLATE(marker_random, pool<4096>);
+BENCHMARK_TEMPLATE(marker_random, bitset<4096>);
+BENCHMARK_TEMPLATE(marker_random, hbitset<4096>);
+BENCHMARK_TEMPLATE(marker_random, segregated_list<4096>);
+
+// Holes of `state.range(0)` indexes are separated by a single allocated index and followed by one
+// hole twice as large at the end, which is the only one that fits the request. `pool` only supports
+// single indexes so it isn't benchmarked.
+template<typename Marker>
+static void marker_fragmentation(benchmark::State & state)
+{
+  auto m = std::make_unique<Marker>();
+  auto const hole = static_cast<std::size_t>(state.range(0));
+  auto const size = static_cast<std::size_t>(m->size());
+  allocate_all(*m);
+  auto free = [&m](std::size_t first, std::size_t last) {
+    for (auto i = first; i != last; ++i)
+    {
+      m->deallocate(static_cast<index_t<Marker>>(i), 1);
+    }
+  };
+  for (std::size_t i = 0; i + 3 * hole < size; i += hole + 1)
+  {
+    free(i, i + hole);
+  }
+  free(size - 2 * hole, size);
+  auto const n = static_cast<index_t<Marker>>(2 * hole);
+  for (auto _ : state)
+  {
+    auto i = m->allocate(n);
+    benchmark::DoNotOptimize(i);
+    m->deallocate(i, n);
+  }
+}
+BENCHMARK_TEMPLATE(marker_fragmentation, list<255>)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(marker_fragmentation, bitset<255>)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(marker_fragmentation, hbitset<255>)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(marker_fragmentation, segregated_list<255>)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(marker_fragmentation, bitset<4096>)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(marker_fragmentation, hbitset<4096>)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(marker_fragmentation, segregated_list<4096>)->RangeMultiplier(2)->Range(1, 8);
+
+// Construction into storage that has already been touched, which is what `free_block` does when it
+// grows into a new chunk.
+template<typename Marker>
+static void marker_construct(benchmark::State & state)
+{
+  alignas(Marker) static unsigned char storage[sizeof(Marker)];
+  for (auto _ : state)
+  {
+    auto m = ::new (static_cast<void *>(storage)) Marker();
+    benchmark::DoNotOptimize(m);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_TEMPLATE(marker_construct, pool<255>);
+BENCHMARK_TEMPLATE(marker_construct, pool<65536>);
+BENCHMARK_TEMPLATE(marker_construct, bitset<65536>);
\ No newline at end of file
@@ -1,27 +1,134 @@
 #pragma once
 
-#include "detail/static_vector.h" // static_vector
-#include "traits.h" // is_resource_v
+#include "detail/dynamic_vector.h" // chunk_vector
+#include "traits.h" // is_resource_v, resource_traits, allocation_result
 
 #include <cassert> // assert
 #include <cstddef> // size_t, byte
+#include <cstdint> // uintptr_t
 #include <functional> // less, less_equal
-#include <memory> // pointer_traits
-#include <utility> // forward, exchange
+#include <memory> // pointer_traits, addressof
+#include <utility> // forward, swap
 
 namespace kp11
 {
+  /// @brief Growth policy of `monotonic` where every chunk is `ChunkSize` bytes. Requests larger
+  /// than a chunk aren't supported.
+  struct fixed_chunks
+  {
+    /// Requests larger than a chunk aren't passed through to `Upstream`.
+    static constexpr bool passthrough = false;
+    /// @returns `chunk_size`
+    static constexpr std::size_t size(std::size_t chunk_size, std::size_t) noexcept
+    {
+      return chunk_size;
+    }
+  };
+  /// @brief Growth policy of `monotonic` where each chunk is `Factor` times larger than the one
+  /// before it, up to `MaxChunkSize` bytes. Requests larger than the next chunk are allocated
+  /// directly from `Upstream`.
+  ///
+  /// @tparam MaxChunkSize Maximum size in bytes of a chunk. Should be a multiple of
+  /// `ChunkAlignment`.
+  /// @tparam Factor Growth factor.
+  template<std::size_t MaxChunkSize, std::size_t Factor = 2>
+  struct geometric_chunks
+  {
+    static_assert(Factor > 1);
+
+    /// Requests larger than the next chunk are passed through to `Upstream`.
+    static constexpr bool passthrough = true;
+    /// @returns `chunk_size * Factor^i` or `MaxChunkSize` if that is smaller.
+    static constexpr std::size_t size(std::size_t chunk_size, std::size_t i) noexcept
+    {
+      for (; i != 0 && chunk_size < MaxChunkSize; --i)
+      {
+        chunk_size = chunk_size <= MaxChunkSize / Factor ? chunk_size * Factor : MaxChunkSize;
+      }
+      return chunk_size < MaxChunkSize ? chunk_size : MaxChunkSize;
+    }
+  };
+
+  /// @brief Retention policy of `monotonic::reset` that keeps no chunks, which makes it the same
+  /// as `monotonic::release`.
+  struct keep_none
+  {
+    /// @returns `0`
+    std::size_t keep(std::size_t) noexcept
+    {
+      return 0;
+    }
+  };
+  /// @brief Retention policy of `monotonic::reset` that keeps up to `K` chunks.
+  ///
+  /// @tparam K Maximum number of chunks kept.
+  template<std::size_t K>
+  struct keep_chunks
+  {
+    /// @returns `K`
+    std::size_t keep(std::size_t) noexcept
+    {
+      return K;
+    }
+  };
+  /// @brief Retention policy of `monotonic::reset` that keeps as many chunks as the most that were
+  /// used by any of the last `N` cycles, up to `K`. Memory is trimmed after `N` quieter cycles.
+  ///
+  /// @tparam N Number of cycles remembered.
+  /// @tparam K Maximum number of chunks kept.
+  template<std::size_t N, std::size_t K = static_cast<std::size_t>(-1)>
+  class keep_recent
+  {
+    static_assert(N > 0);
+
+  public: // modifiers
+    /// Remember `used` as the number of chunks used by this cycle.
+    ///
+    /// @returns Most chunks used by any of the last `N` cycles, up to `K`.
+    std::size_t keep(std::size_t used) noexcept
+    {
+      history[cycle++ % N] = used;
+      std::size_t n = 0;
+      for (auto x : history)
+      {
+        n = x > n ? x : n;
+      }
+      return n < K ? n : K;
+    }
+
+  private: // variables
+    std::size_t cycle = 0;
+    std::size_t history[N] = {};
+  };
+
   /// @brief Advance a pointer through single allocations from `Upstream`. Deallocation is a no-op.
   ///
-  /// @tparam ChunkSize Size in bytes of a request to `Upstream`.
-  /// @tparam ChunkAlignment Alignment in bytes of a request to `Upstream` and alignment of blocks
-  /// and the block size.
-  /// @tparam MaxChunks Maximum number of concurrent allocations from `Upstream`.
+  /// Memory can be deallocated in bulk by `rewind`ing to an earlier `checkpoint`. Chunks that are
+  /// no longer in use after a `rewind` are kept to be reused instead of being deallocated.
+  /// Similarly `reset` deallocates everything but keeps chunks according to `Retention`, so that a
+  /// resource used for one request at a time doesn't go to `Upstream` for every request.
+  ///
+  /// With a `Growth` policy such as `geometric_chunks` the chunks get larger as more are needed,
+  /// and requests that are larger than the next chunk are allocated directly from `Upstream`
+  /// without abandoning the current chunk. Both are released by `release`.
+  ///
+  /// @tparam ChunkSize Size in bytes of the first request to `Upstream`.
+  /// Each request is only padded to its own alignment, so small objects can share a chunk with a
+  /// large `ChunkAlignment`. Requests aligned to more than `ChunkAlignment` are aligned within the
+  /// chunk.
+  ///
+  /// @tparam ChunkAlignment Alignment in bytes of a request to `Upstream`.
+  /// @tparam MaxChunks Maximum number of concurrent allocations from `Upstream`, including
+  /// requests that were passed through, or `dynamic_chunks` for no limit.
   /// @tparam Upstream Meets the `Resource` concept.
+  /// @tparam Growth `fixed_chunks` or `geometric_chunks`.
+  /// @tparam Retention `keep_none`, `keep_chunks` or `keep_recent`.
   template<std::size_t ChunkSize,
     std::size_t ChunkAlignment,
     std::size_t MaxChunks,
-    typename Upstream>
+    typename Upstream,
+    typename Growth = fixed_chunks,
+    typename Retention = keep_none>
   class monotonic
   {
     static_assert(is_resource_v<Upstream>);
@@ -34,43 +141,73 @@ namespace kp11
     using size_type = typename Upstream::size_type;
 
   public: // constants
-    /// Size in bytes of request to `Upstream`.
+    /// Size in bytes of the first request to `Upstream`.
     static constexpr auto chunk_size = ChunkSize;
-    /// Alignment in bytes of request to `Upstream` and alignment of blocks.
+    /// Alignment in bytes of request to `Upstream`.
     static constexpr auto chunk_alignment = ChunkAlignment;
     /// Maximum number of concurrent allocations from `Upstream`.
     static constexpr auto max_chunks = MaxChunks;
-    /// Size in bytes of a free block.
-    static constexpr auto block_size = ChunkAlignment;
 
   private: // typedefs
     /// Byte pointer for arithmetic purposes.
     using byte_pointer = typename std::pointer_traits<pointer>::template rebind<std::byte>;
+    /// An allocation from `Upstream`.
+    struct chunk
+    {
+      byte_pointer ptr;
+      size_type size;
+      /// Passed through to `Upstream` rather than allocated from.
+      bool oversized;
+    };
+
+  public: // typedefs
+    /// State returned by `checkpoint` that can be returned to with `rewind`.
+    struct checkpoint_type
+    {
+      /// Number of chunks in use.
+      std::size_t used;
+      /// Current position in the current chunk.
+      byte_pointer first;
+      /// End of the current chunk.
+      byte_pointer last;
+    };
 
   public: // constructors
     /// Defined because other constructors are defined.
     monotonic() = default;
     /// Deleted because a resource is being held and managed.
     monotonic(monotonic const &) = delete;
-    /// Defined because the destructor is defined. `x` is left is a valid but unspecified state.
+    /// Defined because the destructor is defined. `x` is left empty.
     monotonic(monotonic && x) noexcept :
-        first(x.first), last(x.last), ptrs(std::move(x.ptrs)), upstream(std::move(x.upstream))
+        first(x.first), last(x.last), num_grown(x.num_grown), used(x.used),
+        chunks(std::move(x.chunks)), retention(std::move(x.retention)),
+        upstream(std::move(x.upstream))
     {
-      x.ptrs.clear();
+      x.chunks.clear();
+      x.first = x.last = nullptr;
+      x.num_grown = 0;
+      x.used = 0;
     }
     /// Deleted because a resource is being held and managed.
     monotonic & operator=(monotonic const &) = delete;
-    /// Defined because the destructor is defined. `x` is left is a valid but unspecified state.
+    /// Defined because the destructor is defined. `x` is left empty.
     monotonic & operator=(monotonic && x) noexcept
     {
       if (this != &x)
       {
+        release();
         first = x.first;
         last = x.last;
-        ptrs = std::move(x.ptrs);
+        num_grown = x.num_grown;
+        used = x.used;
+        chunks = std::move(x.chunks);
+        retention = std::move(x.retention);
         upstream = std::move(x.upstream);
 
-        x.ptrs.clear();
+        x.chunks.clear();
+        x.first = x.last = nullptr;
+        x.num_grown = 0;
+        x.used = 0;
       }
       return *this;
     }
@@ -81,15 +218,24 @@ namespace kp11
     }
 
   public: // capacity
-    /// @returns The maximum allocation size supported.
+    /// @returns The maximum allocation size supported. This is `chunk_size` unless `Growth` passes
+    /// larger requests through to `Upstream`.
     static constexpr size_type max_size() noexcept
     {
-      return chunk_size;
+      if constexpr (Growth::passthrough)
+      {
+        return resource_traits<Upstream>::max_size();
+      }
+      else
+      {
+        return chunk_size;
+      }
     }
 
   public: // modifiers
     /// Try to allocate from the latest memory block. Otherwise try to allocate a new memory block
-    /// from `Upstream` and allocates from this new memory block.
+    /// from `Upstream` and allocates from this new memory block. If `size` is larger than the new
+    /// memory block would be then it is allocated directly from `Upstream` instead.
     /// * Complexity `O(1)`
     ///
     /// @param size Size in bytes of memory to allocate.
@@ -98,21 +244,29 @@ namespace kp11
     /// @returns (success) Pointer to the beginning of a suitable memory block.
     /// @returns (failure) `nullptr`
     ///
-    /// @pre `chunk_alignment % alignment == 0`
+    /// @pre `alignment` is a power of two.
     /// @pre `size <= max_size()`
-    pointer allocate(size_type size, [[maybe_unused]] size_type alignment) noexcept
+    pointer allocate(size_type size, size_type alignment) noexcept
     {
-      assert(chunk_alignment % alignment == 0);
       assert(size <= max_size());
-      size = round_up_to_our_alignment(size);
-      if (auto ptr = allocate_from_back(size))
+      size = bytes(size);
+      if (auto ptr = allocate_from_back(size, alignment))
       {
         return ptr;
       }
-      else if (push_back())
+      auto const needed = worst_case(size, alignment);
+      if (needed < size)
+      {
+        return nullptr;
+      }
+      else if (needed > next_chunk_size())
+      {
+        return Growth::passthrough ? allocate_oversized(size, alignment) : nullptr;
+      }
+      else if (push_back(needed))
       {
-        // This call should not fail as a full buffer should be able to fulfil any request made.
-        auto ptr = allocate_from_back(size);
+        // This call should not fail as a new chunk has room for the worst case padding.
+        auto ptr = allocate_from_back(size, alignment);
         assert(ptr != nullptr);
         return ptr;
       }
@@ -121,58 +275,357 @@ namespace kp11
         return nullptr;
       }
     }
+    /// Same as `allocate` but also returns the usable size, which is `size`, or `1` if `size` is
+    /// `0`.
+    /// * Complexity `O(1)`
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment in bytes of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block and its usable size.
+    /// @returns (failure) `nullptr` and `0`.
+    ///
+    /// @pre `alignment` is a power of two.
+    /// @pre `size <= max_size()`
+    allocation_result<pointer, size_type> allocate_at_least(
+      size_type size, size_type alignment) noexcept
+    {
+      if (auto ptr = allocate(size, alignment))
+      {
+        return {ptr, bytes(size)};
+      }
+      return {nullptr, 0};
+    }
+    /// Advance the pointer once for as many allocations as fit in the current chunk, and then
+    /// allocate new chunks from `Upstream` for the rest. Each allocation is `size` rounded up to
+    /// `alignment` after the one before it.
+    /// * Complexity `O(n)`
+    ///
+    /// @param size Size in bytes of each allocation.
+    /// @param alignment Alignment in bytes of each allocation.
+    /// @param n Number of allocations.
+    /// @param out Written with the pointer to each allocation.
+    ///
+    /// @returns Number of allocations written to the front of `out`. Less than `n` if we ran out
+    /// of memory.
+    ///
+    /// @pre `alignment` is a power of two.
+    /// @pre `size <= max_size()`
+    size_type allocate_bulk(
+      size_type size, size_type alignment, size_type n, pointer * out) noexcept
+    {
+      assert(size <= max_size());
+      size = bytes(size);
+      size_type done = 0;
+      auto const needed = worst_case(size, alignment);
+      if (needed < size || needed > next_chunk_size())
+      {
+        for (; done != n && (out[done] = allocate(size, alignment)); ++done)
+        {
+        }
+        return done;
+      }
+      auto const stride = size % alignment == 0 ? size : (size / alignment + 1) * alignment;
+      while (done != n)
+      {
+        if (first != last)
+        {
+          auto const pad = padding(first, alignment);
+          if (auto const space = static_cast<size_type>(last - first);
+              pad <= space && size <= space - pad)
+          {
+            auto const p = first + pad;
+            auto const room = (space - pad - size) / stride + 1;
+            auto const fit = room < n - done ? room : n - done;
+            for (size_type k = 0; k != fit; ++k)
+            {
+              out[done + k] = static_cast<pointer>(p + k * stride);
+            }
+            first = p + (fit - 1) * stride + size;
+            done += fit;
+          }
+        }
+        if (done != n && !push_back(needed))
+        {
+          break;
+        }
+      }
+      return done;
+    }
+    /// Grow `ptr` in place if it is the most recent allocation and the current memory block has
+    /// room for `new_size`.
+    /// * Complexity `O(1)`
+    ///
+    /// @param ptr Pointer returned by a call to `allocate`.
+    /// @param old_size Corresponding argument to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    ///
+    /// @pre `old_size <= new_size`
+    bool expand(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      assert(old_size <= new_size);
+      if (new_size > max_size())
+      {
+        return false;
+      }
+      auto const p = static_cast<byte_pointer>(ptr);
+      if (first && p + bytes(old_size) == first &&
+          bytes(new_size) <= static_cast<size_type>(last - p))
+      {
+        first = p + bytes(new_size);
+        return true;
+      }
+      return false;
+    }
+    /// Shrink `ptr` in place. The memory is only recovered if it is the most recent allocation.
+    /// * Complexity `O(1)`
+    ///
+    /// @param ptr Pointer returned by a call to `allocate`.
+    /// @param old_size Corresponding argument to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns `true`
+    ///
+    /// @pre `new_size <= old_size`
+    bool shrink(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      assert(new_size <= old_size);
+      auto const p = static_cast<byte_pointer>(ptr);
+      if (first && p + bytes(old_size) == first)
+      {
+        first = p + bytes(new_size);
+      }
+      return true;
+    }
     /// No-op.
     /// * Complexity `O(0)`
     void deallocate(pointer, size_type, size_type) noexcept
     {
     }
-    /// Deallocate allocated memory back to `Upstream` and clear all metadata.
+    /// No-op.
+    /// * Complexity `O(0)`
+    void deallocate_bulk(pointer const *, size_type, size_type, size_type) noexcept
+    {
+    }
+    /// Deallocate allocated memory back to `Upstream` and clear all metadata. Invalidates every
+    /// checkpoint.
     void release() noexcept
     {
-      for (auto && p : ptrs)
+      for (auto && c : chunks)
       {
-        upstream.deallocate(static_cast<pointer>(p), chunk_size, chunk_alignment);
+        upstream.deallocate(static_cast<pointer>(c.ptr), c.size, chunk_alignment);
       }
-      ptrs.clear();
+      chunks.clear();
       last = first = nullptr;
+      num_grown = 0;
+      used = 0;
+    }
+    /// Deallocate everything, like `release`, but keep the number of chunks given by `Retention`
+    /// to be reused. The largest chunks are kept. Invalidates every checkpoint.
+    /// * Complexity `O(MaxChunks^2)`
+    void reset() noexcept
+    {
+      auto const keep = retention.keep(used);
+      rewind({0, nullptr, nullptr});
+      while (chunks.size() > keep)
+      {
+        std::size_t smallest = 0;
+        for (std::size_t i = 1; i != chunks.size(); ++i)
+        {
+          smallest = chunks[i].size < chunks[smallest].size ? i : smallest;
+        }
+        upstream.deallocate(
+          static_cast<pointer>(chunks[smallest].ptr), chunks[smallest].size, chunk_alignment);
+        chunks[smallest] = chunks.back();
+        chunks.pop_back();
+      }
+      if (chunks.empty())
+      {
+        num_grown = 0;
+      }
+    }
+    /// Deallocate the chunks that are kept for reuse.
+    /// * Complexity `O(MaxChunks)`
+    void shrink_to_fit() noexcept
+    {
+      while (chunks.size() != used)
+      {
+        auto const & c = chunks.back();
+        upstream.deallocate(static_cast<pointer>(c.ptr), c.size, chunk_alignment);
+        chunks.pop_back();
+      }
+    }
+    /// @returns The current state, which can be returned to with `rewind`.
+    /// * Complexity `O(1)`
+    checkpoint_type checkpoint() const noexcept
+    {
+      return {used, first, last};
+    }
+    /// Deallocate everything allocated since `cp` was returned by `checkpoint`. Chunks that were
+    /// started since then are kept to be reused by later allocations, except for requests that
+    /// were passed through to `Upstream`, which are deallocated.
+    /// * Complexity `O(MaxChunks)`
+    ///
+    /// @param cp Returned by a call to `checkpoint`.
+    ///
+    /// @pre `cp` hasn't been invalidated by `release` or by a `rewind` to an earlier checkpoint.
+    void rewind(checkpoint_type cp) noexcept
+    {
+      assert(cp.used <= used);
+      // Keep the chunks that can be reused together at the end.
+      auto w = cp.used;
+      for (auto i = cp.used; i != chunks.size(); ++i)
+      {
+        if (i < used && chunks[i].oversized)
+        {
+          upstream.deallocate(static_cast<pointer>(chunks[i].ptr), chunks[i].size, chunk_alignment);
+        }
+        else
+        {
+          chunks[w++] = chunks[i];
+        }
+      }
+      while (chunks.size() != w)
+      {
+        chunks.pop_back();
+      }
+      used = cp.used;
+      first = cp.first;
+      last = cp.last;
     }
 
   private: // allocate helpers
-    static constexpr size_type round_up_to_our_alignment(size_type size) noexcept
+    /// @returns Number of bytes taken up by a request of `size`. A request of `0` takes up a byte
+    /// so that every allocation has a different address.
+    static constexpr size_type bytes(size_type size) noexcept
+    {
+      return size == 0 ? 1 : size;
+    }
+    /// @returns Number of bytes needed at the beginning of a chunk for `size` aligned to
+    /// `alignment`. Less than `size` on overflow.
+    static constexpr size_type worst_case(size_type size, size_type alignment) noexcept
+    {
+      return alignment > chunk_alignment ? size + (alignment - chunk_alignment) : size;
+    }
+    /// @returns Number of bytes to skip for `ptr` to be aligned to `alignment`.
+    static size_type padding(byte_pointer ptr, size_type alignment) noexcept
     {
-      return size == 0 ? block_size : (size / block_size + (size % block_size != 0)) * block_size;
+      auto const address = reinterpret_cast<std::uintptr_t>(std::addressof(*ptr));
+      return static_cast<size_type>((alignment - address % alignment) % alignment);
     }
-    /// @pre `size % block_size == 0`.
-    pointer allocate_from_back(size_type size) noexcept
+    /// Align the current position to `alignment` and advance it past `size` if there is room.
+    pointer allocate_from_back(size_type size, size_type alignment) noexcept
     {
-      assert(size % block_size == 0);
-      if (auto space = static_cast<size_type>(last - first); size <= space)
+      if (first == last)
       {
-        return static_cast<pointer>(std::exchange(first, first + size));
+        return nullptr;
+      }
+      auto const pad = padding(first, alignment);
+      if (auto const space = static_cast<size_type>(last - first);
+          pad <= space && size <= space - pad)
+      {
+        auto const ptr = first + pad;
+        first = ptr + size;
+        return static_cast<pointer>(ptr);
+      }
+      return nullptr;
+    }
+    /// @returns Size in bytes of the chunk that `push_back` would allocate.
+    size_type next_chunk_size() const noexcept
+    {
+      return static_cast<size_type>(Growth::size(chunk_size, num_grown));
+    }
+    /// Allocate `size` bytes aligned to `alignment` directly from `Upstream` and remember it so
+    /// that it is released. The current memory block is kept.
+    ///
+    /// @pre `worst_case(size, alignment) >= size`
+    pointer allocate_oversized(size_type size, size_type alignment) noexcept
+    {
+      if (!make_room())
+      {
+        return nullptr;
+      }
+      auto const needed = worst_case(size, alignment);
+      if (auto ptr = static_cast<byte_pointer>(upstream.allocate(needed, chunk_alignment)))
+      {
+        emplace_used(chunk{ptr, needed, true});
+        return static_cast<pointer>(ptr + padding(ptr, alignment));
       }
       return nullptr;
     }
 
   private: // modifiers
-    /// Allocate a chunk from `Upstream`. Can fail if max chunks has been reached or if `Upstream`
-    /// fails allocation.
+    /// Start a chunk that can hold at least `size` bytes. A kept chunk is reused if one is large
+    /// enough, otherwise a chunk is allocated from `Upstream`. Can fail if max chunks has been
+    /// reached or if `Upstream` fails allocation.
     ///
     /// @returns (success) `true`
     /// @returns (failure) `false`
-    bool push_back() noexcept
+    ///
+    /// @pre `size <= next_chunk_size()`
+    bool push_back(size_type size) noexcept
     {
-      if (ptrs.size() == ptrs.capacity())
+      assert(size <= next_chunk_size());
+      for (auto i = used; i != chunks.size(); ++i)
+      {
+        if (chunks[i].size >= size)
+        {
+          std::swap(chunks[i], chunks[used]);
+          start(chunks[used++]);
+          return true;
+        }
+      }
+      if (!make_room())
       {
         return false;
       }
-      if (auto ptr = upstream.allocate(chunk_size, chunk_alignment))
+      auto const n = next_chunk_size();
+      if (auto ptr = upstream.allocate(n, chunk_alignment))
       {
-        first = ptrs.emplace_back(static_cast<byte_pointer>(ptr));
-        last = first + chunk_size;
+        start(emplace_used(chunk{static_cast<byte_pointer>(ptr), n, false}));
+        ++num_grown;
         return true;
       }
       return false;
     }
+    /// Make `c` the chunk that is allocated from.
+    void start(chunk const & c) noexcept
+    {
+      first = c.ptr;
+      last = first + c.size;
+    }
+    /// Make sure that there is room for another chunk by growing a `dynamic_chunks` index or by
+    /// deallocating a kept chunk if needed.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    bool make_room() noexcept
+    {
+      if (chunks.grow())
+      {
+        return true;
+      }
+      if (used == chunks.size())
+      {
+        return false;
+      }
+      auto const & c = chunks.back();
+      upstream.deallocate(static_cast<pointer>(c.ptr), c.size, chunk_alignment);
+      chunks.pop_back();
+      return true;
+    }
+    /// Add `c` to the end of the chunks in use, before the kept chunks.
+    ///
+    /// @pre `chunks.size() != chunks.capacity()`
+    chunk & emplace_used(chunk c) noexcept
+    {
+      chunks.emplace_back(c);
+      std::swap(chunks.back(), chunks[used]);
+      return chunks[used++];
+    }
 
   public: // observers
     /// Check whether or not `ptr` points into an allocation from `Upstream`.
@@ -183,12 +636,13 @@ namespace kp11
     /// @returns (failure) `nullptr`
     pointer operator[](pointer ptr) const noexcept
     {
-      for (auto && p : ptrs)
+      for (std::size_t i = 0; i != used; ++i)
       {
-        if (std::less_equal<pointer>()(static_cast<pointer>(p), ptr) &&
-            std::less<pointer>()(ptr, static_cast<pointer>(p + chunk_size)))
+        auto && c = chunks[i];
+        if (std::less_equal<pointer>()(static_cast<pointer>(c.ptr), ptr) &&
+            std::less<pointer>()(ptr, static_cast<pointer>(c.ptr + c.size)))
         {
-          return static_cast<pointer>(p);
+          return static_cast<pointer>(c.ptr);
         }
       }
       return nullptr;
@@ -211,8 +665,41 @@ namespace kp11
     byte_pointer first = nullptr;
     /// End of allocatable memory.
     byte_pointer last = nullptr;
-    /// Holds pointers to memory allocated by `Upstream`
-    kp11::detail::static_vector<byte_pointer, max_chunks> ptrs;
+    /// Number of chunks allocated by `push_back`, which is the index into `Growth`.
+    std::size_t num_grown = 0;
+    /// Number of chunks in use. The rest of `chunks` are kept for reuse.
+    std::size_t used = 0;
+    /// Holds memory allocated by `Upstream`
+    kp11::detail::chunk_vector<chunk, max_chunks> chunks;
+    Retention retention;
     Upstream upstream;
   };
+
+  /// @brief Rewinds a resource, such as `monotonic`, to its `checkpoint` when the scope ends so
+  /// that everything allocated inside of the scope is deallocated at once.
+  ///
+  /// @tparam Resource Provides `checkpoint()` and `rewind(checkpoint_type)`.
+  template<typename Resource>
+  class rewind_scope
+  {
+  public: // constructors
+    /// Take a checkpoint of `resource`.
+    explicit rewind_scope(Resource & resource) noexcept :
+        resource(resource), point(resource.checkpoint())
+    {
+    }
+    /// Deleted because the scope can only be ended once.
+    rewind_scope(rewind_scope const &) = delete;
+    /// Deleted because the scope can only be ended once.
+    rewind_scope & operator=(rewind_scope const &) = delete;
+    /// Rewind `resource` to the checkpoint.
+    ~rewind_scope() noexcept
+    {
+      resource.rewind(point);
+    }
+
+  private: // variables
+    Resource & resource;
+    typename Resource::checkpoint_type point;
+  };
 }
\ No newline at end of file
@@ -1,10 +1,13 @@
 #include "monotonic.h"
 
 #include "heap.h" // heap
-#include "traits.h" // is_owner_v
+#include "replay.h" // footprint
+#include "traits.h" // is_owner_v, resource_traits
 
 #include <catch.hpp>
 
+#include <cstdint> // uintptr_t
+
 using namespace kp11;
 
 TEST_CASE("max_size", "[max_size]")
@@ -14,16 +17,29 @@ TEST_CASE("max_size", "[max_size]")
 }
 TEST_CASE("constructor", "[constructor]")
 {
-  monotonic<128, 4, 2, heap> m;
+  monotonic<64, 16, 4, heap> m;
+  auto a = m.allocate(32, 16);
+  REQUIRE(a != nullptr);
   SECTION("move")
   {
     auto n = std::move(m);
+    REQUIRE(n[a] == a);
   }
   SECTION("move assignment")
   {
     decltype(m) n;
+    REQUIRE(n.allocate(32, 16) != nullptr);
     n = std::move(m);
+    REQUIRE(n[a] == a);
   }
+  // The moved from resource is empty and usable.
+  REQUIRE(m[a] == nullptr);
+  m.shrink_to_fit();
+  auto b = m.allocate(32, 16);
+  REQUIRE(b != nullptr);
+  REQUIRE(m[b] == b);
+  m.release();
+  REQUIRE(m.allocate(64, 16) != nullptr);
 }
 TEST_CASE("accessor", "[accessor]")
 {
@@ -49,6 +65,290 @@ TEST_CASE("allocate", "[allocate]")
     }
   }
 }
+TEST_CASE("alignment", "[allocate]")
+{
+  SECTION("requests are only padded to their own alignment")
+  {
+    monotonic<4096, 4096, 2, footprint<heap>> m;
+    auto a = static_cast<char *>(m.allocate(16, 16));
+    REQUIRE(m.allocate(16, 16) == a + 16);
+    REQUIRE(m.allocate(1, 1) == a + 32);
+    REQUIRE(m.allocate(8, 8) == a + 40);
+    REQUIRE(m.allocate(0, 1) == a + 48);
+    REQUIRE(m.allocate(0, 1) == a + 49);
+    REQUIRE(m.get_upstream().bytes() == 4096);
+  }
+  SECTION("greater than chunk alignment")
+  {
+    monotonic<128, 4, 2, heap> m;
+    m.allocate(4, 4);
+    auto a = m.allocate(8, 64);
+    REQUIRE(a != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(a) % 64 == 0);
+    REQUIRE(m.allocate(128, 64) == nullptr);
+  }
+  SECTION("greater than chunk alignment passed through")
+  {
+    monotonic<64, 4, 2, footprint<heap>, geometric_chunks<64>> m;
+    auto a = m.allocate(64, 256);
+    REQUIRE(a != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(a) % 256 == 0);
+    REQUIRE(m.get_upstream().bytes() == 64 + 256 - 4);
+    m.release();
+    REQUIRE(m.get_upstream().bytes() == 0);
+  }
+  SECTION("bulk")
+  {
+    monotonic<128, 4, 2, heap> m;
+    void * ptrs[4] = {};
+    m.allocate(1, 1);
+    REQUIRE(m.allocate_bulk(20, 16, 4, ptrs) == 4);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(ptrs[0]) % 16 == 0);
+    // 3 fit in the rest of the first chunk.
+    for (int i = 1; i != 3; ++i)
+    {
+      REQUIRE(static_cast<char *>(ptrs[i]) - static_cast<char *>(ptrs[i - 1]) == 32);
+    }
+    REQUIRE(m[ptrs[0]] == m[ptrs[2]]);
+    REQUIRE(m[ptrs[0]] != m[ptrs[3]]);
+  }
+}
+TEST_CASE("allocate_at_least", "[allocate]")
+{
+  monotonic<128, 4, 2, heap> m;
+  auto a = m.allocate_at_least(5, 4);
+  REQUIRE(a.ptr != nullptr);
+  REQUIRE(a.count == 5);
+  REQUIRE(m.allocate_at_least(0, 1).count == 1);
+}
+TEST_CASE("expand/shrink", "[expand/shrink]")
+{
+  monotonic<128, 4, 2, heap> m;
+  auto a = static_cast<char *>(m.allocate(8, 4));
+  REQUIRE(m.expand(a, 8, 16) == true);
+  auto b = static_cast<char *>(m.allocate(4, 4));
+  REQUIRE(b == a + 16);
+  REQUIRE(m.expand(a, 16, 20) == false);
+  REQUIRE(m.expand(b, 4, 200) == false);
+  REQUIRE(m.expand(b, 4, 112) == true);
+  REQUIRE(m.expand(b, 112, 116) == false);
+  REQUIRE(m.shrink(a, 16, 8) == true);
+  REQUIRE(m.shrink(b, 112, 4) == true);
+  REQUIRE(m.allocate(4, 4) == b + 4);
+}
+TEST_CASE("allocate_bulk", "[allocate_bulk]")
+{
+  monotonic<128, 4, 2, heap> m;
+  void * ptrs[64] = {};
+  SECTION("single chunk")
+  {
+    REQUIRE(m.allocate_bulk(30, 4, 4, ptrs) == 4);
+    for (int i = 1; i != 4; ++i)
+    {
+      REQUIRE(static_cast<char *>(ptrs[i]) - static_cast<char *>(ptrs[i - 1]) == 32);
+    }
+  }
+  SECTION("across chunks")
+  {
+    REQUIRE(m.allocate_bulk(32, 4, 6, ptrs) == 6);
+    REQUIRE(m[ptrs[0]] != m[ptrs[5]]);
+    REQUIRE(m.allocate_bulk(32, 4, 6, ptrs) == 2);
+    REQUIRE(m.allocate(4, 4) == nullptr);
+    m.deallocate_bulk(ptrs, 32, 4, 2);
+  }
+}
+TEST_CASE("geometric_chunks", "[growth]")
+{
+  REQUIRE(geometric_chunks<256>::size(64, 0) == 64);
+  REQUIRE(geometric_chunks<256>::size(64, 1) == 128);
+  REQUIRE(geometric_chunks<256>::size(64, 2) == 256);
+  REQUIRE(geometric_chunks<256>::size(64, 3) == 256);
+  REQUIRE(geometric_chunks<1000, 3>::size(64, 2) == 576);
+  REQUIRE(geometric_chunks<1000, 3>::size(64, 3) == 1000);
+  REQUIRE(fixed_chunks::size(64, 3) == 64);
+}
+TEST_CASE("growth", "[growth]")
+{
+  monotonic<64, 4, 4, footprint<heap>, geometric_chunks<256>> m;
+  REQUIRE(m.max_size() == resource_traits<heap>::max_size());
+  SECTION("chunks grow")
+  {
+    auto a = m.allocate(64, 4);
+    REQUIRE(m.get_upstream().bytes() == 64);
+    auto b = m.allocate(128, 4);
+    REQUIRE(m.get_upstream().bytes() == 64 + 128);
+    REQUIRE(m[a] != m[b]);
+    m.allocate(4, 4);
+    REQUIRE(m.get_upstream().bytes() == 64 + 128 + 256);
+    m.release();
+    REQUIRE(m.get_upstream().bytes() == 0);
+    SECTION("growth restarts after release")
+    {
+      m.allocate(4, 4);
+      REQUIRE(m.get_upstream().bytes() == 64);
+    }
+  }
+  SECTION("oversized requests are passed through")
+  {
+    auto a = m.allocate(4, 4);
+    auto b = m.allocate(1000, 4);
+    REQUIRE(b != nullptr);
+    REQUIRE(m[b] == b);
+    REQUIRE(m.get_upstream().bytes() == 64 + 1000);
+    // The current chunk is still used.
+    auto c = m.allocate(4, 4);
+    REQUIRE(m[c] == m[a]);
+    REQUIRE(m.get_upstream().bytes() == 64 + 1000);
+    m.release();
+    REQUIRE(m.get_upstream().bytes() == 0);
+  }
+  SECTION("passed through requests count towards MaxChunks")
+  {
+    for (int i = 0; i != 4; ++i)
+    {
+      REQUIRE(m.allocate(1000, 4) != nullptr);
+    }
+    REQUIRE(m.allocate(1000, 4) == nullptr);
+    REQUIRE(m.allocate(4, 4) == nullptr);
+  }
+}
+TEST_CASE("dynamic_chunks", "[dynamic_chunks]")
+{
+  monotonic<128, 4, dynamic_chunks, footprint<heap>> m;
+  REQUIRE(sizeof(m) < sizeof(monotonic<128, 4, 8, footprint<heap>>));
+  for (int i = 0; i < 100; ++i)
+  {
+    auto a = m.allocate(128, 4);
+    REQUIRE(a != nullptr);
+    REQUIRE(m[a] == a);
+  }
+  // The index of chunks isn't allocated from upstream.
+  REQUIRE(m.get_upstream().bytes() == 100 * 128);
+  SECTION("release")
+  {
+    m.release();
+    REQUIRE(m.get_upstream().bytes() == 0);
+    REQUIRE(m.allocate(128, 4) != nullptr);
+  }
+  SECTION("move assignment")
+  {
+    decltype(m) n;
+    REQUIRE(n.allocate(128, 4) != nullptr);
+    n = std::move(m);
+    REQUIRE(n.allocate(128, 4) != nullptr);
+  }
+}
+TEST_CASE("rewind", "[rewind]")
+{
+  monotonic<128, 4, 3, footprint<heap>, geometric_chunks<256>> m;
+  auto a = m.allocate(64, 4);
+  auto cp = m.checkpoint();
+  SECTION("same chunk")
+  {
+    auto b = m.allocate(32, 4);
+    m.rewind(cp);
+    REQUIRE(m.allocate(32, 4) == b);
+  }
+  SECTION("chunks are kept for reuse")
+  {
+    auto b = m.allocate(128, 4);
+    REQUIRE(m[b] != m[a]);
+    REQUIRE(m.get_upstream().bytes() == 128 + 256);
+    m.rewind(cp);
+    REQUIRE(m[b] == nullptr);
+    REQUIRE(m.get_upstream().bytes() == 128 + 256);
+    // Fits in the rest of the first chunk.
+    REQUIRE(m[m.allocate(64, 4)] == m[a]);
+    // Reuses the kept chunk.
+    REQUIRE(m.allocate(128, 4) == b);
+    REQUIRE(m.get_upstream().bytes() == 128 + 256);
+  }
+  SECTION("passed through requests are deallocated")
+  {
+    auto b = m.allocate(1000, 4);
+    REQUIRE(m[b] == b);
+    m.rewind(cp);
+    REQUIRE(m[b] == nullptr);
+    REQUIRE(m.get_upstream().bytes() == 128);
+  }
+  SECTION("nested")
+  {
+    m.allocate(128, 4);
+    auto inner = m.checkpoint();
+    auto c = m.allocate(256, 4);
+    m.rewind(inner);
+    REQUIRE(m.allocate(256, 4) == c);
+    m.rewind(cp);
+    REQUIRE(m.get_upstream().bytes() == 128 + 256 + 256);
+  }
+  SECTION("kept chunks are deallocated to make room")
+  {
+    m.allocate(128, 4);
+    m.rewind(cp);
+    REQUIRE(m.allocate(1000, 4) != nullptr);
+    REQUIRE(m.allocate(1000, 4) != nullptr);
+    REQUIRE(m.get_upstream().bytes() == 128 + 2000);
+  }
+  SECTION("scope")
+  {
+    {
+      rewind_scope scope(m);
+      m.allocate(64, 4);
+      m.allocate(64, 4);
+    }
+    auto b = m.allocate(64, 4);
+    REQUIRE(m[b] == m[a]);
+  }
+  m.release();
+  REQUIRE(m.get_upstream().bytes() == 0);
+}
+TEST_CASE("reset", "[reset]")
+{
+  SECTION("keep_none")
+  {
+    monotonic<128, 4, 3, footprint<heap>> m;
+    m.allocate(128, 4);
+    m.reset();
+    REQUIRE(m.get_upstream().bytes() == 0);
+  }
+  SECTION("keep_chunks")
+  {
+    monotonic<128, 4, 3, footprint<heap>, geometric_chunks<512>, keep_chunks<2>> m;
+    m.allocate(128, 4);
+    auto b = m.allocate(256, 4);
+    m.allocate(512, 4);
+    m.allocate(1000, 4);
+    m.reset();
+    // The largest chunks are kept and the passed through request is deallocated.
+    REQUIRE(m.get_upstream().bytes() == 256 + 512);
+    REQUIRE(m.allocate(256, 4) != nullptr);
+    REQUIRE(m.get_upstream().bytes() == 256 + 512);
+    m.shrink_to_fit();
+    REQUIRE(m.get_upstream().bytes() == 512);
+    m.reset();
+    REQUIRE(m.allocate(200, 4) != b);
+    REQUIRE(m.get_upstream().bytes() == 512);
+  }
+  SECTION("keep_recent")
+  {
+    monotonic<128, 4, 3, footprint<heap>, fixed_chunks, keep_recent<2>> m;
+    m.allocate(128, 4);
+    m.allocate(128, 4);
+    m.allocate(128, 4);
+    m.reset();
+    REQUIRE(m.get_upstream().bytes() == 3 * 128);
+    m.allocate(128, 4);
+    m.reset();
+    REQUIRE(m.get_upstream().bytes() == 3 * 128);
+    m.allocate(128, 4);
+    m.reset();
+    REQUIRE(m.get_upstream().bytes() == 128);
+    m.reset();
+    REQUIRE(m.get_upstream().bytes() == 128);
+    m.reset();
+    REQUIRE(m.get_upstream().bytes() == 0);
+  }
+}
 TEST_CASE("operator[]", "[operator[]]")
 {
   monotonic<128, 4, 2, heap> m;
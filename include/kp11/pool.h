@@ -15,6 +15,10 @@ namespace kp11
   /// The node points to the next node by using an index. `allocate` and `deallocate` calls are each
   /// limited to 1 index.
   ///
+  /// Indexes that have never been allocated aren't in the list. They are handed out in order by
+  /// advancing a cursor once the list is empty, so that construction is `O(1)` and the array is
+  /// only touched as indexes are used.
+  ///
   /// @tparam N Total number of indexes.
   template<std::size_t N>
   class pool
@@ -32,12 +36,9 @@ namespace kp11
           std::conditional_t<N <= UINT_LEAST64_MAX, uint_least64_t, uintmax_t>>>>;
 
   public: // constructors
+    /// Provided so that `next` isn't zero initialized by value initialization.
     pool() noexcept
     {
-      for (size_type i = 0, last = size(); i < last; ++i)
-      {
-        next[i] = i + 1;
-      }
     }
 
   public: // capacity
@@ -56,10 +57,16 @@ namespace kp11
     {
       return static_cast<size_type>(1);
     }
+    /// @returns Largest `n` that `allocate(n)` would currently succeed with. This is `1` unless
+    /// every index is allocated.
+    size_type largest_free_run() const noexcept
+    {
+      return static_cast<size_type>(num_occupied != size());
+    }
 
   public: // modifiers
     /// The next node becomes the head of the linked list. Returns the index of the previous head
-    /// node.
+    /// node. If the list is empty then the next index that has never been allocated is returned.
     /// * Complexity `O(1)`
     ///
     /// @param n Number of indexes to allocate.
@@ -82,8 +89,38 @@ namespace kp11
         ++num_occupied;
         return std::exchange(head, next[head]);
       }
+      if (cursor != size())
+      {
+        ++num_occupied;
+        return cursor++;
+      }
       return size();
     }
+    /// Pop up to `count` nodes off of the linked list and then advance the cursor for the rest.
+    /// * Complexity `O(count)`
+    ///
+    /// @param n Number of indexes in each allocation.
+    /// @param count Number of allocations.
+    /// @param out Written with the index of each allocation.
+    ///
+    /// @returns Number of allocations written to the front of `out`.
+    ///
+    /// @pre `n == 1`
+    size_type allocate_bulk(size_type n, size_type count, size_type * out) noexcept
+    {
+      assert(n == 1);
+      size_type i = 0;
+      for (; i != count && head != size(); ++i)
+      {
+        out[i] = std::exchange(head, next[head]);
+      }
+      for (; i != count && cursor != size(); ++i)
+      {
+        out[i] = cursor++;
+      }
+      num_occupied += i;
+      return i;
+    }
     /// The node at `i` becomes the new head node and the head node is pointed at the previous
     /// head node.
     /// * Complexity `O(1)`
@@ -106,9 +143,11 @@ namespace kp11
 
   private: // variables
     size_type num_occupied = 0;
-    /// First free index or `N`.
-    size_type head = 0;
-    /// Holds the index of the next free index.
+    /// First deallocated index or `N`.
+    size_type head = size();
+    /// First index that has never been allocated or `N`.
+    size_type cursor = 0;
+    /// Holds the index of the next deallocated index. Only written by `deallocate`.
     std::array<size_type, N> next;
   };
 }
\ No newline at end of file
@@ -59,6 +59,50 @@ TEST_CASE("deallocate", "[deallocate]")
     auto b = m.allocate(1);
     REQUIRE(b == a);
   }
+  SECTION("recovered indexes are allocated before new ones")
+  {
+    m.allocate(1);
+    auto a = m.allocate(1);
+    m.allocate(1);
+    m.deallocate(a, 1);
+    REQUIRE(m.allocate(1) == a);
+    REQUIRE(m.allocate(1) == 3);
+    REQUIRE(m.count() == 4);
+  }
+}
+TEST_CASE("allocate_bulk", "[allocate_bulk]")
+{
+  pool<10> m;
+  pool<10>::size_type out[10] = {};
+  REQUIRE(m.allocate_bulk(1, 4, out) == 4);
+  REQUIRE(m.count() == 4);
+  for (int i = 0; i != 4; ++i)
+  {
+    REQUIRE(out[i] == i);
+  }
+  SECTION("partial")
+  {
+    REQUIRE(m.allocate_bulk(1, 10, out) == 6);
+    REQUIRE(m.count() == 10);
+    REQUIRE(m.allocate_bulk(1, 1, out) == 0);
+  }
+  SECTION("reuses deallocated indexes")
+  {
+    m.deallocate(2, 1);
+    REQUIRE(m.allocate_bulk(1, 2, out) == 2);
+    REQUIRE(out[0] == 2);
+    REQUIRE(out[1] == 4);
+  }
+}
+TEST_CASE("largest_free_run", "[largest_free_run]")
+{
+  pool<2> m;
+  REQUIRE(m.largest_free_run() == 1);
+  auto a = m.allocate(1);
+  m.allocate(1);
+  REQUIRE(m.largest_free_run() == 0);
+  m.deallocate(a, 1);
+  REQUIRE(m.largest_free_run() == 1);
 }
 TEST_CASE("traits", "[traits]")
 {
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "traits.h" // is_resource_v, resource_traits, is_owner_v, owner_traits
+
+#include <cassert> // assert
+#include <chrono> // steady_clock, duration_cast, nanoseconds
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint32_t, uint8_t, uintptr_t
+#include <cstdio> // FILE, fopen, fwrite, fclose
+#include <memory> // unique_ptr
+#include <new> // nothrow
+#include <type_traits> // enable_if_t
+#include <utility> // move, exchange
+
+namespace kp11
+{
+  /// @brief A single call recorded by `recording`. This is also the layout of a trace file, which
+  /// is the events from oldest to newest in native byte order.
+  struct trace_event
+  {
+    /// Kinds of calls.
+    enum kind_type : std::uint8_t
+    {
+      allocate,
+      deallocate
+    };
+    /// Nanoseconds since the `recording` was constructed or last `clear`ed.
+    std::uint64_t time;
+    /// Address of the memory, which identifies an allocation until it is deallocated. `0` if
+    /// `allocate` failed.
+    std::uint64_t id;
+    /// Size argument of the call.
+    std::uint64_t size;
+    /// Alignment argument of the call.
+    std::uint32_t alignment;
+    /// Kind of call.
+    kind_type kind;
+    /// Always `0`, so that the file has no uninitialized bytes.
+    std::uint8_t reserved[3];
+  };
+  static_assert(sizeof(trace_event) == 32);
+
+  /// @brief Records every call to `Resource` into a ring buffer of the last `N` events, which can
+  /// be written to a trace file and replayed against another resource with `replay`.
+  ///
+  /// If `Resource` is an owner then so are we. Not thread safe, wrap in `synchronized` if needed.
+  ///
+  /// The ring buffer is allocated on construction with `new` rather than being stored in the
+  /// object, so that a recording can be on the stack. If that fails then nothing is recorded.
+  ///
+  /// @tparam Resource Meets the `Resource` concept. `pointer` must be convertible to `void *`.
+  /// @tparam N Number of events kept. Older events are overwritten.
+  template<typename Resource, std::size_t N = 65536>
+  class recording
+  {
+    static_assert(is_resource_v<Resource>);
+    static_assert(N > 0);
+
+  public: // typedefs
+    /// Pointer type
+    using pointer = typename Resource::pointer;
+    /// Size type
+    using size_type = typename resource_traits<Resource>::size_type;
+
+  private: // typedefs
+    using clock = std::chrono::steady_clock;
+
+  public: // constructors
+    recording() noexcept : events(new (std::nothrow) trace_event[N]()), start(clock::now())
+    {
+    }
+    /// Deleted because the ring buffer is held and managed.
+    recording(recording const &) = delete;
+    /// Defined because the ring buffer is held and managed. `x` is left without a ring buffer, so
+    /// it records nothing.
+    recording(recording && x) noexcept :
+        events(std::move(x.events)), total(std::exchange(x.total, 0)), start(x.start),
+        resource(std::move(x.resource))
+    {
+    }
+    /// Deleted because the ring buffer is held and managed.
+    recording & operator=(recording const &) = delete;
+    /// Defined because the ring buffer is held and managed. `x` is left without a ring buffer, so
+    /// it records nothing.
+    recording & operator=(recording && x) noexcept
+    {
+      if (this != &x)
+      {
+        events = std::move(x.events);
+        total = std::exchange(x.total, 0);
+        start = x.start;
+        resource = std::move(x.resource);
+      }
+      return *this;
+    }
+
+  public: // capacity
+    /// @returns The maximum allocation size supported. This is `Resource::max_size()`.
+    static constexpr size_type max_size() noexcept
+    {
+      return resource_traits<Resource>::max_size();
+    }
+    /// @returns Number of events kept, at most `N`.
+    std::size_t size() const noexcept
+    {
+      return total < N ? static_cast<std::size_t>(total) : N;
+    }
+    /// @returns Number of events that have been overwritten.
+    std::uint64_t dropped() const noexcept
+    {
+      return total - size();
+    }
+
+  public: // modifiers
+    /// Call `Resource::allocate` and record the call and its result.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @pre `size <= max_size()`
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      auto ptr = resource.allocate(size, alignment);
+      record(trace_event::allocate, ptr, size, alignment);
+      return ptr;
+    }
+    /// Record the call and then call `Resource::deallocate`.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param size Corresponding argument to call to `allocate`.
+    /// @param alignment Corresponding argument to call to `allocate`.
+    ///
+    /// @returns `true` If `Resource` is an owner and it owns `ptr`.
+    /// @returns `false` If `Resource` is an owner and it doesn't own `ptr`.
+    auto deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      if constexpr (is_owner_v<Resource>)
+      {
+        auto const owned = owner_traits<Resource>::deallocate(resource, ptr, size, alignment);
+        if (owned)
+        {
+          record(trace_event::deallocate, ptr, size, alignment);
+        }
+        return owned;
+      }
+      else
+      {
+        record(trace_event::deallocate, ptr, size, alignment);
+        resource.deallocate(ptr, size, alignment);
+      }
+    }
+    /// Forget every event and restart the clock.
+    void clear() noexcept
+    {
+      total = 0;
+      start = clock::now();
+    }
+
+  public: // observers
+    /// Call `Resource::operator[]`. Only declared if `Resource` is an owner so that we aren't
+    /// detected as an owner otherwise.
+    ///
+    /// @param ptr Pointer to memory.
+    template<typename R = Resource, typename = std::enable_if_t<is_owner_v<R>>>
+    pointer operator[](pointer ptr) noexcept
+    {
+      return resource[ptr];
+    }
+    /// @returns The `i`th oldest event kept.
+    ///
+    /// @pre `i < size()`
+    trace_event const & event(std::size_t i) const noexcept
+    {
+      assert(i < size());
+      return events[static_cast<std::size_t>((total - size() + i) % N)];
+    }
+    /// Write the events kept from oldest to newest to a trace file.
+    ///
+    /// @param path Path of the file, which is overwritten.
+    ///
+    /// @returns `true` If every event was written.
+    /// @returns `false` If the file couldn't be opened or written.
+    bool dump(char const * path) const noexcept
+    {
+      auto file = std::fopen(path, "wb");
+      if (!file)
+      {
+        return false;
+      }
+      // The kept events are at most two contiguous ranges of the ring buffer.
+      auto const first = static_cast<std::size_t>((total - size()) % N);
+      auto const n = size();
+      auto const head = first + n <= N ? n : N - first;
+      bool written = std::fwrite(events.get() + first, sizeof(trace_event), head, file) == head &&
+                     std::fwrite(events.get(), sizeof(trace_event), n - head, file) == n - head;
+      return (std::fclose(file) == 0) && written;
+    }
+
+  public: // accessors
+    /// @returns Reference to `Resource`.
+    Resource & get_resource() noexcept
+    {
+      return resource;
+    }
+    /// @returns Reference to `Resource`.
+    Resource const & get_resource() const noexcept
+    {
+      return resource;
+    }
+
+  private: // helpers
+    void record(
+      trace_event::kind_type kind, pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      if (!events)
+      {
+        return;
+      }
+      events[static_cast<std::size_t>(total++ % N)] = {
+        static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count()),
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(static_cast<void *>(ptr))),
+        static_cast<std::uint64_t>(size),
+        static_cast<std::uint32_t>(alignment),
+        kind,
+        {}};
+    }
+
+  private: // variables
+    std::unique_ptr<trace_event[]> events;
+    std::uint64_t total = 0;
+    clock::time_point start;
+    Resource resource;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "recording.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "local.h" // local
+#include "stack.h" // stack
+#include "traits.h" // is_resource_v, is_owner_v
+
+#include <catch.hpp>
+
+#include <cstdint> // uint64_t, uintptr_t
+#include <cstddef> // size_t
+#include <cstdio> // FILE, fopen, fread, fclose, rewind, remove
+
+using namespace kp11;
+
+using owner_t = free_block<128, 4, 1, stack<4>, local<128, 4>>;
+
+namespace
+{
+  std::uint64_t id(void * ptr)
+  {
+    return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr));
+  }
+}
+
+TEST_CASE("max_size", "[max_size]")
+{
+  REQUIRE(recording<owner_t>::max_size() == owner_t::max_size());
+}
+TEST_CASE("constructor", "[constructor]")
+{
+  // The ring buffer isn't stored in the object.
+  REQUIRE(sizeof(recording<heap>) < 1024);
+  recording<heap> m;
+  m.deallocate(m.allocate(32, 4), 32, 4);
+  REQUIRE(m.size() == 2);
+  SECTION("move")
+  {
+    auto n = std::move(m);
+    REQUIRE(n.size() == 2);
+    REQUIRE(n.event(1).kind == trace_event::deallocate);
+    REQUIRE(m.size() == 0);
+    m.deallocate(m.allocate(32, 4), 32, 4);
+    REQUIRE(m.size() == 0);
+  }
+}
+TEST_CASE("accessor", "[accessor]")
+{
+  recording<owner_t, 4> m;
+  [[maybe_unused]] owner_t & a = m.get_resource();
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  recording<owner_t, 4> m;
+  auto a = m.allocate(32, 4);
+  REQUIRE(m[a] == a);
+  REQUIRE(m.size() == 1);
+  REQUIRE(m.event(0).kind == trace_event::allocate);
+  REQUIRE(m.event(0).id == id(a));
+  REQUIRE(m.event(0).size == 32);
+  REQUIRE(m.event(0).alignment == 4);
+  SECTION("failure")
+  {
+    m.allocate(128, 4);
+    REQUIRE(m.size() == 2);
+    REQUIRE(m.event(1).id == 0);
+    REQUIRE(m.event(1).time >= m.event(0).time);
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  SECTION("owner")
+  {
+    recording<owner_t, 4> m;
+    auto a = m.allocate(32, 4);
+    REQUIRE(m.deallocate(a, 32, 4) == true);
+    REQUIRE(m.size() == 2);
+    REQUIRE(m.event(1).kind == trace_event::deallocate);
+    REQUIRE(m.event(1).id == id(a));
+    int x;
+    REQUIRE(m.deallocate(&x, 32, 4) == false);
+    REQUIRE(m.size() == 2);
+  }
+  SECTION("not an owner")
+  {
+    recording<heap, 4> m;
+    auto a = m.allocate(32, 4);
+    m.deallocate(a, 32, 4);
+    REQUIRE(m.size() == 2);
+    REQUIRE(m.event(1).kind == trace_event::deallocate);
+  }
+}
+TEST_CASE("ring buffer", "[ring buffer]")
+{
+  recording<owner_t, 4> m;
+  for (int i = 0; i < 3; ++i)
+  {
+    auto a = m.allocate(32, 4);
+    m.deallocate(a, 32, 4);
+  }
+  REQUIRE(m.size() == 4);
+  REQUIRE(m.dropped() == 2);
+  REQUIRE(m.event(0).kind == trace_event::allocate);
+  REQUIRE(m.event(3).kind == trace_event::deallocate);
+  m.clear();
+  REQUIRE(m.size() == 0);
+  REQUIRE(m.dropped() == 0);
+}
+TEST_CASE("dump", "[dump]")
+{
+  recording<owner_t, 4> m;
+  auto a = m.allocate(32, 4);
+  auto b = m.allocate(64, 4);
+  m.deallocate(a, 32, 4);
+  m.deallocate(b, 64, 4);
+  m.allocate(16, 4);
+  REQUIRE(m.dump("recording.trace") == true);
+  auto file = std::fopen("recording.trace", "rb");
+  REQUIRE(file != nullptr);
+  trace_event e;
+  for (std::size_t i = 0; i < m.size(); ++i)
+  {
+    REQUIRE(std::fread(&e, sizeof(e), 1, file) == 1);
+    REQUIRE(e.time == m.event(i).time);
+    REQUIRE(e.size == m.event(i).size);
+  }
+  REQUIRE(std::fread(&e, sizeof(e), 1, file) == 0);
+  SECTION("no uninitialized bytes")
+  {
+    std::rewind(file);
+    unsigned char bytes[sizeof(trace_event)];
+    REQUIRE(std::fread(bytes, sizeof(bytes), 1, file) == 1);
+    for (std::size_t i = sizeof(trace_event) - 3; i != sizeof(trace_event); ++i)
+    {
+      REQUIRE(bytes[i] == 0);
+    }
+  }
+  std::fclose(file);
+  std::remove("recording.trace");
+  REQUIRE(m.dump("missing/recording.trace") == false);
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_owner_v<recording<owner_t>> == true);
+  REQUIRE(is_resource_v<recording<heap>> == true);
+  REQUIRE(is_owner_v<recording<heap>> == false);
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "recording.h" // trace_event
+#include "traits.h" // is_resource_v, resource_traits
+
+#include <algorithm> // max
+#include <chrono> // steady_clock, duration
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstdio> // FILE, fopen, fread, fclose
+#include <unordered_map> // unordered_map
+#include <vector> // vector
+
+namespace kp11
+{
+  /// @brief Counts the bytes held from `Upstream` so that the footprint of a composition can be
+  /// measured by `replay`. Use it as the `Upstream` of the outermost resources of the composition.
+  ///
+  /// @tparam Upstream Meets the `Resource` concept.
+  template<typename Upstream>
+  class footprint
+  {
+    static_assert(is_resource_v<Upstream>);
+
+  public: // typedefs
+    /// Pointer type
+    using pointer = typename Upstream::pointer;
+    /// Size type
+    using size_type = typename resource_traits<Upstream>::size_type;
+
+  public: // capacity
+    /// @returns The maximum allocation size supported. This is `Upstream::max_size()`.
+    static constexpr size_type max_size() noexcept
+    {
+      return resource_traits<Upstream>::max_size();
+    }
+    /// @returns Number of bytes currently held from `Upstream`.
+    std::uint64_t bytes() const noexcept
+    {
+      return current;
+    }
+    /// @returns Greatest number of bytes held from `Upstream` at any one time.
+    std::uint64_t peak() const noexcept
+    {
+      return highest;
+    }
+
+  public: // modifiers
+    /// Call `Upstream::allocate` and count the bytes if it succeeds.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      auto ptr = upstream.allocate(size, alignment);
+      if (ptr)
+      {
+        current += size;
+        highest = std::max(highest, current);
+      }
+      return ptr;
+    }
+    /// Call `Upstream::deallocate` and stop counting the bytes.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param size Corresponding argument to call to `allocate`.
+    /// @param alignment Corresponding argument to call to `allocate`.
+    void deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      current -= size;
+      upstream.deallocate(ptr, size, alignment);
+    }
+
+  private: // variables
+    std::uint64_t current = 0;
+    std::uint64_t highest = 0;
+    Upstream upstream;
+  };
+
+  /// Results of a `replay`.
+  struct replay_result
+  {
+    /// Number of `allocate` calls made.
+    std::uint64_t allocations = 0;
+    /// Number of `allocate` calls that returned `nullptr`.
+    std::uint64_t failures = 0;
+    /// Number of `deallocate` calls made.
+    std::uint64_t deallocations = 0;
+    /// Time taken by the calls to the resource.
+    std::chrono::duration<double> elapsed{};
+    /// Greatest number of requested bytes allocated at any one time.
+    std::uint64_t peak_bytes = 0;
+
+    /// @returns Calls to the resource per second.
+    double throughput() const noexcept
+    {
+      return static_cast<double>(allocations + deallocations) / elapsed.count();
+    }
+    /// @param footprint Peak number of bytes held from upstream e.g. `footprint::peak()`.
+    ///
+    /// @returns Fraction of `footprint` that wasn't requested at the peak.
+    double fragmentation(std::uint64_t footprint) const noexcept
+    {
+      return footprint ? 1.0 - static_cast<double>(peak_bytes) / static_cast<double>(footprint)
+                       : 0.0;
+    }
+  };
+
+  /// Read a trace file written by `recording::dump`.
+  ///
+  /// @param path Path of the file.
+  ///
+  /// @returns The events in the file. Empty if the file couldn't be read.
+  inline std::vector<trace_event> read_trace(char const * path)
+  {
+    std::vector<trace_event> events;
+    if (auto file = std::fopen(path, "rb"))
+    {
+      trace_event e;
+      while (std::fread(&e, sizeof(e), 1, file) == 1)
+      {
+        events.push_back(e);
+      }
+      std::fclose(file);
+    }
+    return events;
+  }
+
+  /// Make the calls of a trace against `resource` in the same order. Deallocations of memory whose
+  /// allocation isn't in the trace, because it failed or was overwritten, are skipped. Memory that
+  /// is still allocated at the end of the trace is deallocated after timing stops. Allocations are
+  /// matched with their deallocations before timing starts, so only the calls to `resource` are
+  /// timed.
+  ///
+  /// @param resource Meets the `Resource` concept.
+  /// @param events Events of a trace from oldest to newest.
+  ///
+  /// @returns Counts and timings of the calls made.
+  template<typename Resource>
+  replay_result replay(Resource & resource, std::vector<trace_event> const & events)
+  {
+    static_assert(is_resource_v<Resource>);
+    using pointer = typename Resource::pointer;
+    using size_type = typename resource_traits<Resource>::size_type;
+    struct allocation
+    {
+      pointer ptr;
+      size_type size;
+      size_type alignment;
+    };
+    constexpr auto none = static_cast<std::size_t>(-1);
+    // Give every allocation in the trace a slot before timing, so that the timed loop only calls
+    // the resource.
+    std::vector<std::size_t> slots(events.size(), none);
+    std::size_t num_slots = 0;
+    {
+      std::unordered_map<std::uint64_t, std::size_t> open;
+      for (std::size_t i = 0; i != events.size(); ++i)
+      {
+        auto const & e = events[i];
+        if (e.kind == trace_event::allocate)
+        {
+          if (e.id)
+          {
+            slots[i] = num_slots;
+            open[e.id] = num_slots++;
+          }
+        }
+        else if (auto it = open.find(e.id); it != open.end())
+        {
+          slots[i] = it->second;
+          open.erase(it);
+        }
+      }
+    }
+    std::vector<allocation> live(num_slots, allocation{nullptr, 0, 0});
+    replay_result result;
+    std::uint64_t bytes = 0;
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i != events.size(); ++i)
+    {
+      auto const & e = events[i];
+      auto const size = static_cast<size_type>(e.size);
+      auto const alignment = static_cast<size_type>(e.alignment);
+      if (e.kind == trace_event::allocate)
+      {
+        ++result.allocations;
+        auto ptr = resource.allocate(size, alignment);
+        if (!ptr)
+        {
+          ++result.failures;
+        }
+        else if (slots[i] != none)
+        {
+          live[slots[i]] = {ptr, size, alignment};
+          bytes += e.size;
+          result.peak_bytes = std::max(result.peak_bytes, bytes);
+        }
+        else
+        {
+          // Failed in the trace so it is never deallocated there.
+          resource.deallocate(ptr, size, alignment);
+        }
+      }
+      else if (slots[i] != none && live[slots[i]].ptr)
+      {
+        auto & a = live[slots[i]];
+        ++result.deallocations;
+        resource.deallocate(a.ptr, a.size, a.alignment);
+        bytes -= a.size;
+        a.ptr = nullptr;
+      }
+    }
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    for (auto const & a : live)
+    {
+      if (a.ptr)
+      {
+        resource.deallocate(a.ptr, a.size, a.alignment);
+      }
+    }
+    return result;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "replay.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "list.h" // list
+#include "pool.h" // pool
+#include "recording.h" // recording
+#include "traits.h" // is_resource_v
+
+#include <catch.hpp>
+
+#include <cstdio> // remove
+#include <vector> // vector
+
+using namespace kp11;
+
+TEST_CASE("footprint", "[footprint]")
+{
+  REQUIRE(is_resource_v<footprint<heap>> == true);
+  footprint<heap> m;
+  auto a = m.allocate(64, 4);
+  auto b = m.allocate(32, 4);
+  REQUIRE(m.bytes() == 96);
+  m.deallocate(a, 64, 4);
+  REQUIRE(m.bytes() == 32);
+  REQUIRE(m.peak() == 96);
+  m.deallocate(b, 32, 4);
+  REQUIRE(m.bytes() == 0);
+}
+TEST_CASE("read_trace", "[read_trace]")
+{
+  recording<heap, 4> m;
+  auto a = m.allocate(32, 4);
+  m.deallocate(a, 32, 4);
+  REQUIRE(m.dump("replay.trace") == true);
+  auto events = read_trace("replay.trace");
+  std::remove("replay.trace");
+  REQUIRE(events.size() == 2);
+  REQUIRE(events[0].kind == trace_event::allocate);
+  REQUIRE(events[1].kind == trace_event::deallocate);
+  REQUIRE(events[0].id == events[1].id);
+  REQUIRE(read_trace("missing.trace").empty());
+}
+TEST_CASE("replay", "[replay]")
+{
+  recording<heap> trace;
+  std::vector<void *> ptrs;
+  for (int i = 0; i < 8; ++i)
+  {
+    ptrs.push_back(trace.allocate(16, 16));
+  }
+  for (int i = 0; i < 8; i += 2)
+  {
+    trace.deallocate(ptrs[i], 16, 16);
+  }
+  std::vector<trace_event> events;
+  for (std::size_t i = 0; i < trace.size(); ++i)
+  {
+    events.push_back(trace.event(i));
+  }
+  SECTION("success")
+  {
+    using resource_t = free_block<128, 16, 1, list<8>, footprint<heap>>;
+    resource_t r;
+    auto result = replay(r, events);
+    REQUIRE(result.allocations == 8);
+    REQUIRE(result.failures == 0);
+    REQUIRE(result.deallocations == 4);
+    REQUIRE(result.peak_bytes == 128);
+    REQUIRE(result.throughput() > 0);
+    REQUIRE(result.fragmentation(256) == 0.5);
+    REQUIRE(result.fragmentation(0) == 0);
+    // Memory still allocated at the end is deallocated.
+    REQUIRE(r.allocate(128, 16) != nullptr);
+  }
+  SECTION("failure")
+  {
+    free_block<64, 16, 1, pool<4>, heap> r;
+    auto result = replay(r, events);
+    REQUIRE(result.allocations == 8);
+    REQUIRE(result.failures == 4);
+    REQUIRE(result.deallocations == 2);
+    REQUIRE(result.peak_bytes == 64);
+  }
+  for (int i = 1; i < 8; i += 2)
+  {
+    trace.deallocate(ptrs[i], 16, 16);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,292 @@
+#include "bitset.h" // bitset
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "list.h" // list
+#include "monotonic.h" // monotonic
+#include "pool.h" // pool
+#include "segregated_list.h" // segregated_list
+#include "traits.h" // resource_traits
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // shuffle
+#include <cstddef> // size_t, byte
+#include <cstdint> // int64_t
+#include <memory> // allocator, make_unique
+#include <memory_resource> // memory_resource, unsynchronized_pool_resource, monotonic_buffer_resource
+#include <random> // mt19937
+#include <vector> // vector
+
+using namespace kp11;
+
+// Allocation patterns shared by every resource and by the standard library allocators for
+// comparison. Every request is for `block_size` bytes so that every resource can serve the batch
+// patterns, which allocate `state.range(0)` blocks and then deallocate them in the order given by
+// the pattern.
+
+namespace
+{
+  constexpr std::size_t block_size = 64;
+  constexpr std::size_t num_blocks = 255;
+
+  template<typename Marker>
+  using block_t = free_block<block_size * num_blocks, block_size, 1, Marker, heap>;
+  using monotonic_t = monotonic<block_size * num_blocks, block_size, 1, heap>;
+  using monotonic_kept_t =
+    monotonic<block_size * num_blocks, block_size, 1, heap, fixed_chunks, keep_chunks<1>>;
+
+  /// Adapts `std::allocator` to the `Resource` concept.
+  class std_allocator
+  {
+  public: // typedefs
+    using pointer = void *;
+    using size_type = std::size_t;
+
+  public: // modifiers
+    pointer allocate(size_type size, size_type) noexcept
+    {
+      return a.allocate(size);
+    }
+    void deallocate(pointer ptr, size_type size, size_type) noexcept
+    {
+      a.deallocate(static_cast<std::byte *>(ptr), size);
+    }
+
+  private: // variables
+    std::allocator<std::byte> a;
+  };
+
+  /// Adapts a `std::pmr::memory_resource` to the `Resource` concept.
+  template<typename MemoryResource>
+  class std_pmr
+  {
+  public: // typedefs
+    using pointer = void *;
+    using size_type = std::size_t;
+
+  public: // modifiers
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      return r.allocate(size, alignment);
+    }
+    void deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      r.deallocate(ptr, size, alignment);
+    }
+    void release() noexcept
+    {
+      r.release();
+    }
+
+  private: // variables
+    MemoryResource r;
+  };
+  using pmr_pool_t = std_pmr<std::pmr::unsynchronized_pool_resource>;
+  using pmr_monotonic_t = std_pmr<std::pmr::monotonic_buffer_resource>;
+
+  template<typename Resource>
+  void end_batch(Resource &) noexcept
+  {
+  }
+  /// Monotonic resources never reuse deallocated memory so they are released after every batch.
+  void end_batch(monotonic_t & r) noexcept
+  {
+    r.release();
+  }
+  /// Keeps its chunk so that `Upstream` isn't used after the first batch.
+  void end_batch(monotonic_kept_t & r) noexcept
+  {
+    r.reset();
+  }
+  void end_batch(pmr_monotonic_t & r) noexcept
+  {
+    r.release();
+  }
+
+  template<typename Resource>
+  std::vector<void *> allocate_batch(Resource & r, std::size_t n)
+  {
+    std::vector<void *> ptrs;
+    ptrs.reserve(n);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+      ptrs.push_back(r.allocate(block_size, block_size));
+    }
+    return ptrs;
+  }
+}
+
+template<typename Resource>
+static void resource_pair(benchmark::State & state)
+{
+  auto r = std::make_unique<Resource>();
+  for (auto _ : state)
+  {
+    auto p = r->allocate(block_size, block_size);
+    benchmark::DoNotOptimize(p);
+    r->deallocate(p, block_size, block_size);
+  }
+}
+BENCHMARK_TEMPLATE(resource_pair, heap);
+BENCHMARK_TEMPLATE(resource_pair, block_t<pool<num_blocks>>);
+BENCHMARK_TEMPLATE(resource_pair, block_t<list<num_blocks>>);
+BENCHMARK_TEMPLATE(resource_pair, block_t<bitset<num_blocks>>);
+BENCHMARK_TEMPLATE(resource_pair, block_t<segregated_list<num_blocks>>);
+BENCHMARK_TEMPLATE(resource_pair, std_allocator);
+BENCHMARK_TEMPLATE(resource_pair, pmr_pool_t);
+
+template<typename Resource>
+static void resource_lifo(benchmark::State & state)
+{
+  auto r = std::make_unique<Resource>();
+  auto const n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state)
+  {
+    auto ptrs = allocate_batch(*r, n);
+    for (auto it = ptrs.rbegin(); it != ptrs.rend(); ++it)
+    {
+      r->deallocate(*it, block_size, block_size);
+    }
+    end_batch(*r);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(resource_lifo, heap)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, block_t<pool<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, block_t<list<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, block_t<bitset<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, block_t<segregated_list<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, monotonic_t)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, monotonic_kept_t)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, std_allocator)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, pmr_pool_t)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_lifo, pmr_monotonic_t)->Arg(16)->Arg(num_blocks);
+
+template<typename Resource>
+static void resource_fifo(benchmark::State & state)
+{
+  auto r = std::make_unique<Resource>();
+  auto const n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state)
+  {
+    for (auto p : allocate_batch(*r, n))
+    {
+      r->deallocate(p, block_size, block_size);
+    }
+    end_batch(*r);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(resource_fifo, heap)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, block_t<pool<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, block_t<list<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, block_t<bitset<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, block_t<segregated_list<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, monotonic_t)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, monotonic_kept_t)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, std_allocator)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, pmr_pool_t)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_fifo, pmr_monotonic_t)->Arg(16)->Arg(num_blocks);
+
+template<typename Resource>
+static void resource_random(benchmark::State & state)
+{
+  auto r = std::make_unique<Resource>();
+  auto const n = static_cast<std::size_t>(state.range(0));
+  std::mt19937 rng;
+  for (auto _ : state)
+  {
+    auto ptrs = allocate_batch(*r, n);
+    state.PauseTiming();
+    std::shuffle(ptrs.begin(), ptrs.end(), rng);
+    state.ResumeTiming();
+    for (auto p : ptrs)
+    {
+      r->deallocate(p, block_size, block_size);
+    }
+    end_batch(*r);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(resource_random, heap)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_random, block_t<pool<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_random, block_t<list<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_random, block_t<bitset<num_blocks>>)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_random, block_t<segregated_list<num_blocks>>)
+  ->Arg(16)
+  ->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_random, std_allocator)->Arg(16)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_random, pmr_pool_t)->Arg(16)->Arg(num_blocks);
+
+// `allocate_bulk` against the equivalent loop of `allocate` calls, both through `resource_traits`
+// so that resources without a native `allocate_bulk` measure the fallback.
+template<typename Resource>
+static void resource_bulk(benchmark::State & state)
+{
+  auto r = std::make_unique<Resource>();
+  auto const n = static_cast<std::size_t>(state.range(0));
+  std::vector<void *> ptrs(n);
+  for (auto _ : state)
+  {
+    auto got = resource_traits<Resource>::allocate_bulk(*r, block_size, block_size, n, ptrs.data());
+    benchmark::DoNotOptimize(got);
+    resource_traits<Resource>::deallocate_bulk(*r, ptrs.data(), block_size, block_size, got);
+    end_batch(*r);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(resource_bulk, heap)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_bulk, block_t<pool<num_blocks>>)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_bulk, block_t<list<num_blocks>>)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_bulk, block_t<bitset<num_blocks>>)->Arg(num_blocks);
+BENCHMARK_TEMPLATE(resource_bulk, monotonic_t)->Arg(num_blocks);
+
+// Every block is allocated and then holes of `state.range(0)` blocks separated by a single
+// allocated block are deallocated, followed by one hole twice as large at the end, which is the
+// only one that fits the request. `pool` only serves single blocks so it isn't benchmarked.
+template<typename Resource>
+static void resource_fragmentation(benchmark::State & state)
+{
+  auto r = std::make_unique<Resource>();
+  auto const hole = static_cast<std::size_t>(state.range(0));
+  auto ptrs = allocate_batch(*r, num_blocks);
+  for (std::size_t i = 0; i + 3 * hole < num_blocks; i += hole + 1)
+  {
+    for (std::size_t k = i; k != i + hole; ++k)
+    {
+      r->deallocate(ptrs[k], block_size, block_size);
+      ptrs[k] = nullptr;
+    }
+  }
+  for (std::size_t k = num_blocks - 2 * hole; k != num_blocks; ++k)
+  {
+    r->deallocate(ptrs[k], block_size, block_size);
+    ptrs[k] = nullptr;
+  }
+  auto const size = 2 * hole * block_size;
+  for (auto _ : state)
+  {
+    auto p = r->allocate(size, block_size);
+    benchmark::DoNotOptimize(p);
+    r->deallocate(p, size, block_size);
+  }
+  for (auto p : ptrs)
+  {
+    if (p)
+    {
+      r->deallocate(p, block_size, block_size);
+    }
+  }
+}
+BENCHMARK_TEMPLATE(resource_fragmentation, heap)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(resource_fragmentation, block_t<list<num_blocks>>)
+  ->RangeMultiplier(2)
+  ->Range(1, 8);
+BENCHMARK_TEMPLATE(resource_fragmentation, block_t<bitset<num_blocks>>)
+  ->RangeMultiplier(2)
+  ->Range(1, 8);
+BENCHMARK_TEMPLATE(resource_fragmentation, block_t<segregated_list<num_blocks>>)
+  ->RangeMultiplier(2)
+  ->Range(1, 8);
+BENCHMARK_TEMPLATE(resource_fragmentation, std_allocator)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(resource_fragmentation, pmr_pool_t)->RangeMultiplier(2)->Range(1, 8);
\ No newline at end of file
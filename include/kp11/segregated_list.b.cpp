@@ -0,0 +1,40 @@
+#include "segregated_list.h"
+
+#include "list.h" // list
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef> // size_t
+#include <memory> // make_unique
+
+using namespace kp11;
+
+// Every other index is freed except for a run of 8 at the end, so there are `size() / 2` runs of 1
+// in front of the only run that can fit the request.
+template<typename Marker>
+static void segregated_list_allocate_fragmented(benchmark::State & state)
+{
+  auto m = std::make_unique<Marker>();
+  auto const size = static_cast<std::size_t>(m->size());
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    m->allocate(1);
+  }
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (i % 2 == 0 || i >= size - 8)
+    {
+      m->deallocate(static_cast<typename Marker::size_type>(i), 1);
+    }
+  }
+  for (auto _ : state)
+  {
+    auto i = m->allocate(8);
+    benchmark::DoNotOptimize(i);
+    m->deallocate(i, 8);
+  }
+}
+BENCHMARK_TEMPLATE(segregated_list_allocate_fragmented, list<255>);
+BENCHMARK_TEMPLATE(segregated_list_allocate_fragmented, segregated_list<255>);
+BENCHMARK_TEMPLATE(segregated_list_allocate_fragmented, segregated_list<4096>);
+BENCHMARK_TEMPLATE(segregated_list_allocate_fragmented, segregated_list<4096, best_fit>);
\ No newline at end of file
@@ -0,0 +1,310 @@
+#pragma once
+
+#include "detail/bit.h" // word, word_bits, countr_zero, countl_zero
+#include "list.h" // list_detail::run
+
+#include <array> // array
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <cstdint> // uint_least8_t, uint_least16_t, uint_least32_t, uint_least64_t, uintmax_t, UINT_LEAST8_MAX, UINT_LEAST16_MAX, UINT_LEAST32_MAX, UINT_LEAST64_MAX, UINTMAX_MAX
+#include <type_traits> // conditional_t, is_same_v
+
+namespace kp11
+{
+  /// Fit policy that returns the first run found that is big enough.
+  struct first_fit
+  {
+  };
+  /// Fit policy that returns the smallest run found that is big enough.
+  struct best_fit
+  {
+  };
+
+  /// @brief Segregated fit marker. Free runs are kept in bins of doubly linked lists.
+  ///
+  /// Like `list` each run has its size stored at its beginning and end so that unallocated
+  /// adjacent runs can be merged on a `deallocate` in `O(1)`. Unallocated runs are additionally
+  /// linked into a bin by the `log2` of their size, with a bitmask of the non-empty bins, so that
+  /// `allocate` only has to look at runs that are close in size to the request.
+  ///
+  /// * `first_fit` searches the bin of `n` for the first run that fits, otherwise it takes the
+  /// first run of the next non-empty bin (all of which fit).
+  /// * `best_fit` searches the bin of `n` for the smallest run that fits, otherwise it searches the
+  /// next non-empty bin for its smallest run.
+  ///
+  /// @tparam N Total number of indexes.
+  /// @tparam Fit `first_fit` or `best_fit`.
+  template<std::size_t N, typename Fit = first_fit>
+  class segregated_list
+  {
+    static_assert(N <= UINTMAX_MAX);
+    static_assert(std::is_same_v<Fit, first_fit> || std::is_same_v<Fit, best_fit>);
+
+  public: // typedefs
+    /// Size type is the smallest type possible that can hold `N` to reduce our array sizes.
+    using size_type = std::conditional_t<N <= UINT_LEAST8_MAX,
+      uint_least8_t,
+      std::conditional_t<N <= UINT_LEAST16_MAX,
+        uint_least16_t,
+        std::conditional_t<N <= UINT_LEAST32_MAX,
+          uint_least32_t,
+          std::conditional_t<N <= UINT_LEAST64_MAX, uint_least64_t, uintmax_t>>>>;
+
+  private: // typedefs
+    using run = list_detail::run<size_type>;
+    using word = detail::word;
+
+  private: // constants
+    static constexpr std::size_t floor_log2(std::size_t n) noexcept
+    {
+      std::size_t b = 0;
+      for (; n >>= 1; ++b)
+      {
+      }
+      return b;
+    }
+    /// One bin for every possible `log2` of a run size.
+    static constexpr std::size_t num_bins = floor_log2(N) + 1;
+
+  public: // constructors
+    segregated_list() noexcept
+    {
+      heads.fill(size());
+      if constexpr (size() > 0)
+      {
+        set_run(0, size(), size());
+        link(0);
+      }
+    }
+
+  public: // capacity
+    /// @returns Number of allocated indexes.
+    size_type count() const noexcept
+    {
+      return num_allocated;
+    }
+    /// @returns Total number of indexes (`N`).
+    static constexpr size_type size() noexcept
+    {
+      return static_cast<size_type>(N);
+    }
+    /// @returns The maximum allocation size supported.
+    static constexpr size_type max_size() noexcept
+    {
+      return size();
+    }
+    /// @returns Largest `n` that `allocate(n)` would currently succeed with, which is the size of
+    /// the largest run in the highest non-empty bin.
+    /// * Complexity `O(r)` where `r` is the number of runs in the highest non-empty bin.
+    size_type largest_free_run() const noexcept
+    {
+      if (nonempty == 0)
+      {
+        return 0;
+      }
+      size_type n = 0;
+      auto const b = detail::word_bits - 1 - detail::countl_zero(nonempty);
+      for (auto i = heads[b]; i != size(); i = next[i])
+      {
+        n = runs[i].size > n ? runs[i].size : n;
+      }
+      return n;
+    }
+
+  public: // modifiers
+    /// Find an unallocated run for `n` according to `Fit`. The allocated indexes are taken from
+    /// the front of the run and if there are leftovers they remain unallocated in their own bin.
+    /// * Complexity `O(r)` where `r` is the number of runs in the searched bins.
+    ///
+    /// @param n Number of indexes to allocate.
+    ///
+    /// @returns (success) Index of the start of the `n` indexes allocated.
+    /// @returns (failure) `size()`
+    ///
+    /// @pre `n > 0`.
+    /// @pre `n <= max_size()`
+    ///
+    /// @post [`(return value)`, `(return value) + n`) will not returned again from
+    /// any subsequent call to `allocate` unless deallocated.
+    /// @post `count() == (previous) count() + n`.
+    size_type allocate(size_type n) noexcept
+    {
+      assert(n > 0);
+      assert(n <= max_size());
+      if (auto const i = find(n); i != size())
+      {
+        unlink(i);
+        if (auto const m = static_cast<size_type>(runs[i].size - n))
+        {
+          auto const j = static_cast<size_type>(i + n);
+          set_run(j, m, m);
+          link(j);
+        }
+        set_run(i, n, 0);
+        num_allocated += n;
+        return i;
+      }
+      return size();
+    }
+    /// If there are unallocated adjacent runs on either side they are removed from their bins and
+    /// merged.
+    /// * Complexity `O(1)`
+    ///
+    /// @param i Returned by a call to `allocate`.
+    /// @param n Corresponding parameter in the call to `allocate`.
+    ///
+    /// @post [`i`, `i + n`) may be returned by a call to `allocate`.
+    /// @post `count() == (previous) count() - n`.
+    void deallocate(size_type i, size_type n) noexcept
+    {
+      assert(i < size());
+      assert(n > 0);
+      assert(i + n <= size());
+      assert(runs[i].available == 0);
+      assert(runs[i].size == n);
+      assert(runs[i + (n - 1)].available == 0);
+      assert(runs[i + (n - 1)].size == n);
+      num_allocated -= n;
+      if (i > 0 && runs[i - 1].available)
+      {
+        auto const prev = static_cast<size_type>(i - runs[i - 1].size);
+        unlink(prev);
+        n += runs[prev].size;
+        i = prev;
+      }
+      if (auto const next = static_cast<size_type>(i + n); next < size() && runs[next].available)
+      {
+        unlink(next);
+        n += runs[next].size;
+      }
+      set_run(i, n, n);
+      link(i);
+    }
+
+  private: // helpers
+    /// Exists because both the start and end of the run must be set.
+    void set_run(size_type i, size_type n, size_type a) noexcept
+    {
+      assert(i < size());
+      assert(i + n <= size());
+      assert(n > 0);
+      runs[i] = runs[i + (n - 1)] = {a, n};
+    }
+    /// @returns Bin that a run of size `n` belongs in.
+    static std::size_t bin_of(size_type n) noexcept
+    {
+      assert(n > 0);
+      return detail::word_bits - 1 - detail::countl_zero(n);
+    }
+    /// @returns First non-empty bin greater than or equal to `b` otherwise `num_bins`.
+    std::size_t next_bin(std::size_t b) const noexcept
+    {
+      if (b >= num_bins)
+      {
+        return num_bins;
+      }
+      auto const b2 = detail::countr_zero(nonempty & (~word(0) << b));
+      return b2 < num_bins ? b2 : num_bins;
+    }
+    /// Search bin `b` for a run that can fit `n` according to `Fit`.
+    size_type find_in_bin(std::size_t b, size_type n) const noexcept
+    {
+      auto found = size();
+      for (auto i = heads[b]; i != size(); i = next[i])
+      {
+        if (auto const s = runs[i].size; n <= s)
+        {
+          if constexpr (std::is_same_v<Fit, first_fit>)
+          {
+            return i;
+          }
+          else
+          {
+            if (s == n)
+            {
+              return i;
+            }
+            if (found == size() || s < runs[found].size)
+            {
+              found = i;
+            }
+          }
+        }
+      }
+      return found;
+    }
+    /// Look in the bin of `n` first since it may contain runs that don't fit, then fall back to
+    /// the next non-empty bin, where every run fits.
+    size_type find(size_type n) const noexcept
+    {
+      auto const b = bin_of(n);
+      if (nonempty & (word(1) << b))
+      {
+        if (auto const i = find_in_bin(b, n); i != size())
+        {
+          return i;
+        }
+      }
+      if (auto const b2 = next_bin(b + 1); b2 != num_bins)
+      {
+        if constexpr (std::is_same_v<Fit, first_fit>)
+        {
+          return heads[b2];
+        }
+        else
+        {
+          return find_in_bin(b2, n);
+        }
+      }
+      return size();
+    }
+    /// Push the unallocated run at `i` onto the front of its bin.
+    void link(size_type i) noexcept
+    {
+      auto const b = bin_of(runs[i].size);
+      prev[i] = size();
+      next[i] = heads[b];
+      if (heads[b] != size())
+      {
+        prev[heads[b]] = i;
+      }
+      heads[b] = i;
+      nonempty |= word(1) << b;
+    }
+    /// Remove the unallocated run at `i` from its bin.
+    void unlink(size_type i) noexcept
+    {
+      auto const b = bin_of(runs[i].size);
+      if (prev[i] != size())
+      {
+        next[prev[i]] = next[i];
+      }
+      else
+      {
+        heads[b] = next[i];
+      }
+      if (next[i] != size())
+      {
+        prev[next[i]] = prev[i];
+      }
+      if (heads[b] == size())
+      {
+        nonempty &= ~(word(1) << b);
+      }
+    }
+
+  private: // variables
+    size_type num_allocated = 0;
+    /// Bit `b` is set if `heads[b]` is not empty.
+    word nonempty = 0;
+    /// Index of the first unallocated run in each bin, otherwise `size()`.
+    std::array<size_type, num_bins> heads;
+    /// Same layout as `list`. The availability and size is stored at the beginning and the end of
+    /// each run. Only the beginning and end of each run is valid.
+    std::array<run, N> runs;
+    /// Next unallocated run in the same bin. Only valid at the beginning of unallocated runs.
+    std::array<size_type, N> next;
+    /// Previous unallocated run in the same bin. Only valid at the beginning of unallocated runs.
+    std::array<size_type, N> prev;
+  };
+}
\ No newline at end of file
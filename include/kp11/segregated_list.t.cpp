@@ -0,0 +1,194 @@
+#include "segregated_list.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "traits.h" // is_marker_v
+
+#include <catch.hpp>
+
+#include <cstdint> // uint_least8_t, uint_least16_t, uint_least32_t, uint_least64_t
+#include <memory> // make_unique
+#include <type_traits> // is_same_v
+
+using namespace kp11;
+
+TEST_CASE("size", "[size]")
+{
+  SECTION("1")
+  {
+    segregated_list<10> m;
+    REQUIRE(m.size() == 10);
+    REQUIRE(m.max_size() == 10);
+    REQUIRE(m.count() == 0);
+  }
+  SECTION("2")
+  {
+    auto m = std::make_unique<segregated_list<1 << 20>>();
+    REQUIRE(m->size() == 1 << 20);
+    REQUIRE(m->max_size() == 1 << 20);
+    REQUIRE(m->count() == 0);
+    REQUIRE(m->allocate(1 << 20) == 0);
+    REQUIRE(m->count() == 1 << 20);
+  }
+  SECTION("size_type")
+  {
+    REQUIRE(std::is_same_v<segregated_list<255>::size_type, uint_least8_t>);
+    REQUIRE(std::is_same_v<segregated_list<256>::size_type, uint_least16_t>);
+    REQUIRE(std::is_same_v<segregated_list<65536>::size_type, uint_least32_t>);
+  }
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  segregated_list<10> m;
+  SECTION("all vacant")
+  {
+    auto a = m.allocate(5);
+    REQUIRE(a == 0);
+    REQUIRE(m.count() == 5);
+    auto b = m.allocate(5);
+    REQUIRE(b == 5);
+    REQUIRE(m.count() == 10);
+  }
+  SECTION("exact size")
+  {
+    REQUIRE(m.allocate(10) == 0);
+    REQUIRE(m.count() == 10);
+  }
+  SECTION("run that doesn't fit in the same bin")
+  {
+    auto a = m.allocate(2);
+    [[maybe_unused]] auto b = m.allocate(1);
+    auto c = m.allocate(7);
+    m.deallocate(a, 2);
+    m.deallocate(c, 7);
+    // bin 1 holds 2, bin 2 holds 7
+    REQUIRE(m.allocate(3) == c);
+    REQUIRE(m.allocate(2) == a);
+  }
+  SECTION("failure")
+  {
+    m.allocate(10);
+    REQUIRE(m.allocate(1) == m.size());
+  }
+  SECTION("failure fragmented")
+  {
+    auto a = m.allocate(3);
+    [[maybe_unused]] auto b = m.allocate(1);
+    auto c = m.allocate(3);
+    [[maybe_unused]] auto d = m.allocate(3);
+    m.deallocate(a, 3);
+    m.deallocate(c, 3);
+    REQUIRE(m.count() == 4);
+    REQUIRE(m.allocate(4) == m.size());
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  segregated_list<10> m;
+  SECTION("boundary, boundary")
+  {
+    auto a = m.allocate(10);
+    m.deallocate(a, 10);
+    REQUIRE(m.count() == 0);
+    REQUIRE(m.allocate(10) == 0);
+  }
+  SECTION("vacant, vacant")
+  {
+    auto a = m.allocate(3);
+    auto b = m.allocate(4);
+    auto c = m.allocate(3);
+    m.deallocate(a, 3);
+    REQUIRE(m.count() == 7);
+    m.deallocate(c, 3);
+    REQUIRE(m.count() == 4);
+    m.deallocate(b, 4);
+    REQUIRE(m.count() == 0);
+    REQUIRE(m.allocate(10) == 0);
+  }
+  SECTION("occupied, vacant")
+  {
+    [[maybe_unused]] auto a = m.allocate(3);
+    auto b = m.allocate(4);
+    auto c = m.allocate(3);
+    m.deallocate(c, 3);
+    m.deallocate(b, 4);
+    REQUIRE(m.count() == 3);
+    REQUIRE(m.allocate(7) == b);
+  }
+  SECTION("vacant, occupied")
+  {
+    auto a = m.allocate(3);
+    auto b = m.allocate(4);
+    [[maybe_unused]] auto c = m.allocate(3);
+    m.deallocate(a, 3);
+    m.deallocate(b, 4);
+    REQUIRE(m.count() == 3);
+    REQUIRE(m.allocate(7) == a);
+  }
+  SECTION("occupied, occupied")
+  {
+    [[maybe_unused]] auto a = m.allocate(3);
+    auto b = m.allocate(4);
+    [[maybe_unused]] auto c = m.allocate(3);
+    m.deallocate(b, 4);
+    REQUIRE(m.count() == 6);
+    REQUIRE(m.allocate(4) == b);
+  }
+}
+TEST_CASE("fit", "[fit]")
+{
+  // Free runs of 7 (at 0) and 5 (at 8) are both in bin 2.
+  auto fragment = [](auto & m) {
+    auto a = m.allocate(7);
+    [[maybe_unused]] auto b = m.allocate(1);
+    auto c = m.allocate(5);
+    [[maybe_unused]] auto d = m.allocate(3);
+    m.deallocate(c, 5);
+    m.deallocate(a, 7);
+  };
+  SECTION("first fit")
+  {
+    segregated_list<16, first_fit> m;
+    fragment(m);
+    REQUIRE(m.allocate(5) == 0);
+  }
+  SECTION("best fit")
+  {
+    segregated_list<16, best_fit> m;
+    fragment(m);
+    REQUIRE(m.allocate(5) == 8);
+  }
+}
+TEST_CASE("free_block", "[free_block]")
+{
+  // 1 MiB chunks split into 256 byte blocks
+  using resource = free_block<1 << 20, 256, 2, segregated_list<4096, best_fit>, heap>;
+  auto m = std::make_unique<resource>();
+  auto a = m->allocate(1000, 256);
+  auto b = m->allocate(300000, 256);
+  REQUIRE(a != nullptr);
+  REQUIRE(b != nullptr);
+  REQUIRE(m->deallocate(a, 1000, 256) == true);
+  REQUIRE(m->deallocate(b, 300000, 256) == true);
+}
+TEST_CASE("largest_free_run", "[largest_free_run]")
+{
+  segregated_list<10> m;
+  REQUIRE(m.largest_free_run() == 10);
+  auto a = m.allocate(3);
+  auto b = m.allocate(2);
+  m.allocate(1);
+  REQUIRE(m.largest_free_run() == 4);
+  m.deallocate(b, 2);
+  REQUIRE(m.largest_free_run() == 4);
+  m.deallocate(a, 3);
+  REQUIRE(m.largest_free_run() == 5);
+  m.allocate(5);
+  m.allocate(4);
+  REQUIRE(m.largest_free_run() == 0);
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_marker_v<segregated_list<10>> == true);
+  REQUIRE(is_marker_v<segregated_list<10, best_fit>> == true);
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "traits.h" // is_resource_v, resource_traits
+#include "traits.h" // is_resource_v, resource_traits, allocation_result
 
 #include <cassert> // assert
 #include <cstddef> // size_t
@@ -58,6 +58,32 @@ namespace kp11
         return large.allocate(size, alignment);
       }
     }
+    /// If `size <= threshold` calls `allocate_at_least` on `Small` else on `Large`. The usable
+    /// size from `Small` is capped at `threshold` so that `deallocate` with any size up to it goes
+    /// back to `Small`.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block and its usable size.
+    /// @returns (failure) `nullptr` and `0`.
+    ///
+    /// @pre `size <= max_size()`
+    allocation_result<pointer, size_type> allocate_at_least(
+      size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      if (size <= threshold)
+      {
+        auto r = resource_traits<Small>::allocate_at_least(small, size, alignment);
+        r.count = r.count > threshold ? static_cast<size_type>(threshold) : r.count;
+        return r;
+      }
+      else
+      {
+        return resource_traits<Large>::allocate_at_least(large, size, alignment);
+      }
+    }
     /// If `size <= threshold` calls `Small::deallocate` else calls `Large::deallocate`.
     ///
     /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
@@ -91,6 +117,48 @@ namespace kp11
         }
       }
     }
+    /// Tries to grow `ptr` in place with the resource that allocated it. Fails if `new_size` would
+    /// be deallocated by the other resource.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param old_size Corresponding argument to call to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    bool expand(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      if (old_size > threshold)
+      {
+        return resource_traits<Large>::expand(large, ptr, old_size, new_size);
+      }
+      if (new_size <= threshold)
+      {
+        return resource_traits<Small>::expand(small, ptr, old_size, new_size);
+      }
+      return false;
+    }
+    /// Tries to shrink `ptr` in place with the resource that allocated it. Fails if `new_size`
+    /// would be deallocated by the other resource.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param old_size Corresponding argument to call to `allocate`.
+    /// @param new_size Size in bytes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    bool shrink(pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      if (old_size <= threshold)
+      {
+        return resource_traits<Small>::shrink(small, ptr, old_size, new_size);
+      }
+      if (new_size > threshold)
+      {
+        return resource_traits<Large>::shrink(large, ptr, old_size, new_size);
+      }
+      return false;
+    }
 
   public: // observers
     /// Checks whether or not `ptr` is owned by `Small` or `Large`.
@@ -50,6 +50,32 @@ TEST_CASE("allocate", "[allocate]")
     m.deallocate(b, 160, 4);
   }
 }
+TEST_CASE("allocate_at_least", "[allocate]")
+{
+  segregator<48, small_t, large_t> m;
+  auto a = m.allocate_at_least(40, 4); // small
+  REQUIRE(a.ptr != nullptr);
+  REQUIRE(a.count == 48);
+  auto b = m.allocate_at_least(100, 4); // large
+  REQUIRE(b.ptr != nullptr);
+  REQUIRE(b.count == 128);
+  REQUIRE(m.deallocate(a.ptr, a.count, 4) == true);
+  REQUIRE(m.get_small().bytes_in_use() == 0);
+  REQUIRE(m.deallocate(b.ptr, b.count, 4) == true);
+}
+TEST_CASE("expand/shrink", "[expand/shrink]")
+{
+  segregator<64, small_t, large_t> m;
+  auto a = m.allocate(32, 4); // small
+  REQUIRE(m.expand(a, 32, 64) == true);
+  REQUIRE(m.expand(a, 64, 96) == false);
+  auto b = m.allocate(100, 4); // large
+  REQUIRE(m.expand(b, 100, 200) == true);
+  REQUIRE(m.shrink(b, 200, 32) == false);
+  REQUIRE(m.shrink(b, 200, 65) == true);
+  REQUIRE(m.deallocate(b, 65, 4) == true);
+  REQUIRE(m.get_large().bytes_in_use() == 0);
+}
 TEST_CASE("deallocate", "[deallocate]")
 {
   segregator<128, small_t, large_t> m;
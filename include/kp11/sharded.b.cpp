@@ -0,0 +1,43 @@
+#include "sharded.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "pool.h" // pool
+#include "synchronized.h" // synchronized
+
+#include <benchmark/benchmark.h>
+
+using namespace kp11;
+
+namespace
+{
+  using shard_t = synchronized<free_block<64 * 1024, 16, 16, pool<1024>, heap>>;
+}
+
+// Every thread allocates and deallocates a few blocks. Reported as allocations per second against
+// the number of threads.
+template<typename Resource>
+static void sharded_scaling(benchmark::State & state)
+{
+  static Resource r;
+  void * ptrs[4];
+  for (auto _ : state)
+  {
+    for (auto & p : ptrs)
+    {
+      p = r.allocate(64, 16);
+    }
+    for (auto p : ptrs)
+    {
+      r.deallocate(p, 64, 16);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(ptrs));
+}
+BENCHMARK_TEMPLATE(sharded_scaling, shard_t)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(sharded_scaling, sharded<shard_t, 64, by_cpu>)
+  ->ThreadRange(1, 64)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(sharded_scaling, sharded<shard_t, 64, by_thread>)
+  ->ThreadRange(1, 64)
+  ->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "traits.h" // is_owner_v, owner_traits, resource_traits
+
+#include <array> // array
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <functional> // hash
+#include <thread> // this_thread::get_id, thread::id
+#include <type_traits> // is_same_v
+#if defined(__linux__)
+#  include <sched.h> // sched_getcpu
+#endif
+
+namespace kp11
+{
+  /// Shard selection policy that uses the CPU that the calling thread is running on. Falls back
+  /// to `by_thread` where the CPU can't be queried.
+  struct by_cpu
+  {
+  };
+  /// Shard selection policy that uses a hash of the calling thread's id.
+  struct by_thread
+  {
+  };
+
+  /// @brief Spreads allocations over `Shards` instances of `Resource` to reduce contention.
+  ///
+  /// `allocate` goes to the shard of the calling thread according to `Select` and then to the
+  /// other shards if it fails. `deallocate` returns memory to the shard that owns it, which is
+  /// usually the calling thread's shard, so the other shards are only searched if it isn't. Each
+  /// shard is aligned to its own cache line so that shards don't falsely share.
+  ///
+  /// A thread may be moved to another CPU, and memory may be deallocated by a thread other than the
+  /// one that allocated it, so more than one thread can use the same shard at a time.
+  ///
+  /// @tparam Resource Meets the `Owner` concept and is thread safe e.g. `synchronized<...>`.
+  /// @tparam Shards Number of shards.
+  /// @tparam Select `by_cpu` or `by_thread`.
+  template<typename Resource, std::size_t Shards, typename Select = by_cpu>
+  class sharded
+  {
+    static_assert(is_owner_v<Resource>);
+    static_assert(Shards > 0);
+    static_assert(std::is_same_v<Select, by_cpu> || std::is_same_v<Select, by_thread>);
+
+  public: // typedefs
+    /// Pointer type
+    using pointer = typename Resource::pointer;
+    /// Size type
+    using size_type = typename resource_traits<Resource>::size_type;
+
+  public: // constants
+    /// Number of shards.
+    static constexpr std::size_t num_shards = Shards;
+
+  private: // typedefs
+    /// @private
+    struct alignas(64) shard
+    {
+      Resource resource;
+    };
+
+  public: // capacity
+    /// @returns The maximum allocation size supported. This is `Resource::max_size()`.
+    static constexpr size_type max_size() noexcept
+    {
+      return resource_traits<Resource>::max_size();
+    }
+
+  public: // modifiers
+    /// Allocate from the calling thread's shard, then from the other shards in order.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @pre `size <= max_size()`
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      auto const first = this_shard();
+      for (std::size_t k = 0; k != num_shards; ++k)
+      {
+        if (auto ptr = shards[(first + k) % num_shards].resource.allocate(size, alignment))
+        {
+          return ptr;
+        }
+      }
+      return nullptr;
+    }
+    /// Deallocate to the shard that owns `ptr`, starting with the calling thread's shard.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param size Corresponding argument to call to `allocate`.
+    /// @param alignment Corresponding argument to call to `allocate`.
+    ///
+    /// @returns `true` If a shard owns `ptr`.
+    /// @returns `false` If no shard owns `ptr`.
+    bool deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      auto const first = this_shard();
+      for (std::size_t k = 0; k != num_shards; ++k)
+      {
+        if (owner_traits<Resource>::deallocate(
+              shards[(first + k) % num_shards].resource, ptr, size, alignment))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+  public: // observers
+    /// Checks whether or not `ptr` is owned by any of the shards.
+    ///
+    /// @param ptr Pointer to memory.
+    pointer operator[](pointer ptr) noexcept
+    {
+      for (auto & s : shards)
+      {
+        if (auto p = s.resource[ptr])
+        {
+          return p;
+        }
+      }
+      return nullptr;
+    }
+
+  public: // accessors
+    /// @returns Reference to the `Resource` of shard `i`.
+    ///
+    /// @pre `i < num_shards`
+    Resource & get_shard(std::size_t i) noexcept
+    {
+      assert(i < num_shards);
+      return shards[i].resource;
+    }
+    /// @returns Index of the calling thread's shard.
+    static std::size_t this_shard() noexcept
+    {
+      if constexpr (num_shards == 1)
+      {
+        return 0;
+      }
+#if defined(__linux__)
+      if constexpr (std::is_same_v<Select, by_cpu>)
+      {
+        if (auto const cpu = sched_getcpu(); cpu >= 0)
+        {
+          return static_cast<std::size_t>(cpu) % num_shards;
+        }
+      }
+#endif
+      static thread_local auto const h = std::hash<std::thread::id>()(std::this_thread::get_id());
+      return h % num_shards;
+    }
+
+  private: // variables
+    std::array<shard, Shards> shards;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "sharded.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "pool.h" // pool
+#include "synchronized.h" // synchronized
+#include "traits.h" // is_owner_v
+
+#include <catch.hpp>
+
+#include <thread> // thread
+
+using namespace kp11;
+
+using shard_t = synchronized<free_block<64, 16, 1, pool<4>, heap>>;
+
+TEST_CASE("max_size", "[max_size]")
+{
+  REQUIRE(sharded<shard_t, 4>::max_size() == shard_t::max_size());
+}
+TEST_CASE("this_shard", "[this_shard]")
+{
+  REQUIRE(sharded<shard_t, 1>::this_shard() == 0);
+  REQUIRE(sharded<shard_t, 4, by_cpu>::this_shard() < 4);
+  REQUIRE(sharded<shard_t, 4, by_thread>::this_shard() < 4);
+  REQUIRE(sharded<shard_t, 4, by_thread>::this_shard() ==
+          sharded<shard_t, 4, by_thread>::this_shard());
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  sharded<shard_t, 2, by_thread> m;
+  auto const s = m.this_shard();
+  SECTION("this shard first")
+  {
+    auto a = m.allocate(16, 16);
+    REQUIRE(a != nullptr);
+    REQUIRE(m.get_shard(s)[a] == a);
+    REQUIRE(m[a] == a);
+  }
+  SECTION("other shards when full")
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      REQUIRE(m.get_shard(s)[m.allocate(16, 16)] != nullptr);
+    }
+    auto a = m.allocate(16, 16);
+    REQUIRE(a != nullptr);
+    REQUIRE(m.get_shard(s)[a] == nullptr);
+    REQUIRE(m.get_shard(1 - s)[a] == a);
+    for (int i = 0; i < 3; ++i)
+    {
+      REQUIRE(m.allocate(16, 16) != nullptr);
+    }
+    REQUIRE(m.allocate(16, 16) == nullptr);
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  sharded<shard_t, 2, by_thread> m;
+  auto const s = m.this_shard();
+  SECTION("owning shard")
+  {
+    auto a = m.get_shard(1 - s).allocate(16, 16);
+    REQUIRE(m.deallocate(a, 16, 16) == true);
+    REQUIRE(m.get_shard(1 - s).allocate(16, 16) == a);
+  }
+  SECTION("not owned")
+  {
+    int x;
+    REQUIRE(m.deallocate(&x, 16, 16) == false);
+    REQUIRE(m[&x] == nullptr);
+  }
+  SECTION("other thread")
+  {
+    auto a = m.allocate(16, 16);
+    bool result = false;
+    std::thread([&] { result = m.deallocate(a, 16, 16); }).join();
+    REQUIRE(result == true);
+    REQUIRE(m.get_shard(s)[m.allocate(16, 16)] != nullptr);
+  }
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_owner_v<sharded<shard_t, 4>> == true);
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "size_classes.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "pool.h" // pool
+#include "segregator.h" // segregator
+
+#include <benchmark/benchmark.h>
+
+#include <array> // array
+#include <cstddef> // size_t
+#include <random> // minstd_rand, uniform_int_distribution
+
+using namespace kp11;
+
+namespace
+{
+  template<std::size_t BlockSize>
+  using block_t = free_block<BlockSize * 256, 16, 4, pool<256>, heap>;
+
+  using chain_t = segregator<16,
+    block_t<16>,
+    segregator<32,
+      block_t<32>,
+      segregator<48,
+        block_t<48>,
+        segregator<64,
+          block_t<64>,
+          segregator<80,
+            block_t<80>,
+            segregator<96,
+              block_t<96>,
+              segregator<112,
+                block_t<112>,
+                segregator<128,
+                  block_t<128>,
+                  segregator<160,
+                    block_t<160>,
+                    segregator<192,
+                      block_t<192>,
+                      segregator<224, block_t<224>, segregator<256, block_t<256>, block_t<512>>>>>>>>>>>>>;
+
+  using classes_t = size_classes<size_class<16, block_t<16>>,
+    size_class<32, block_t<32>>,
+    size_class<48, block_t<48>>,
+    size_class<64, block_t<64>>,
+    size_class<80, block_t<80>>,
+    size_class<96, block_t<96>>,
+    size_class<112, block_t<112>>,
+    size_class<128, block_t<128>>,
+    size_class<160, block_t<160>>,
+    size_class<192, block_t<192>>,
+    size_class<224, block_t<224>>,
+    size_class<256, block_t<256>>,
+    block_t<512>>;
+
+  std::array<std::size_t, 4096> const & random_sizes()
+  {
+    static auto sizes = [] {
+      std::array<std::size_t, 4096> a;
+      std::minstd_rand rng;
+      std::uniform_int_distribution<std::size_t> dist(1, 256);
+      for (auto & s : a)
+      {
+        s = dist(rng);
+      }
+      return a;
+    }();
+    return sizes;
+  }
+}
+
+// Allocate and deallocate uniformly random sizes so that the size class is unpredictable.
+template<typename Resource>
+static void size_classes_random(benchmark::State & state)
+{
+  static Resource r;
+  auto & sizes = random_sizes();
+  std::size_t k = 0;
+  for (auto _ : state)
+  {
+    auto const size = sizes[k++ % sizes.size()];
+    auto p = r.allocate(size, 16);
+    benchmark::DoNotOptimize(p);
+    r.deallocate(p, size, 16);
+  }
+}
+BENCHMARK_TEMPLATE(size_classes_random, chain_t);
+BENCHMARK_TEMPLATE(size_classes_random, classes_t);
\ No newline at end of file
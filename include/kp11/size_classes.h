@@ -0,0 +1,281 @@
+#pragma once
+
+#include "detail/bit.h" // word, word_bits, countl_zero
+#include "traits.h" // is_resource_v, resource_traits, is_owner_v, owner_traits
+
+#include <array> // array
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <cstdint> // uint_least8_t, SIZE_MAX
+#include <numeric> // gcd
+#include <tuple> // tuple, tuple_element_t, get
+#include <type_traits> // conditional_t, enable_if_t, false_type, true_type
+#include <utility> // index_sequence, make_index_sequence
+
+namespace kp11
+{
+  /// @brief Describes a size class of `size_classes`. Sizes less than or equal to `Threshold`
+  /// that aren't in a smaller size class will be allocated by `Resource`.
+  ///
+  /// @tparam Threshold Threshold size in bytes.
+  /// @tparam Resource Meets the `Resource` concept.
+  template<std::size_t Threshold, typename Resource>
+  struct size_class
+  {
+  };
+
+  namespace size_classes_detail
+  {
+    /// @private
+    template<typename T>
+    struct class_traits
+    {
+      using resource = T;
+      static constexpr std::size_t threshold = SIZE_MAX;
+      static constexpr bool is_size_class = false;
+    };
+    /// @private
+    template<std::size_t Threshold, typename Resource>
+    struct class_traits<size_class<Threshold, Resource>>
+    {
+      using resource = Resource;
+      static constexpr std::size_t threshold = Threshold;
+      static constexpr bool is_size_class = true;
+    };
+  }
+
+  /// @brief Generalization of `segregator` to any number of size classes. Each size is mapped to
+  /// its size class with a table lookup and then dispatched to the class's resource by comparing
+  /// the class index with each index, which compilers turn into a jump table with the calls
+  /// inlined rather than a chain of size comparisons.
+  ///
+  /// The lookup table has an entry for every multiple of the greatest common divisor of the
+  /// thresholds up to the largest threshold, unless that would be more than `max_table_size`
+  /// entries. Then it has an entry for every number of bits in a size, followed by a comparison
+  /// with each threshold that has the same number of bits as the size. Sizes greater than the
+  /// largest threshold are allocated by `Large`.
+  ///
+  /// @tparam Classes Any number of `size_class` in strictly ascending order of their thresholds,
+  /// followed by `Large`, which meets the `Resource` concept.
+  template<typename... Classes>
+  class size_classes
+  {
+    static_assert(sizeof...(Classes) >= 2);
+
+  public: // constants
+    /// Number of size classes, not counting `Large`.
+    static constexpr std::size_t num_classes = sizeof...(Classes) - 1;
+    /// Largest number of entries of a lookup table by multiples of the thresholds' greatest common
+    /// divisor.
+    static constexpr std::size_t max_table_size = 4096;
+
+  private: // typedefs
+    template<typename T>
+    using traits = size_classes_detail::class_traits<T>;
+    using resources_type = std::tuple<typename traits<Classes>::resource...>;
+    template<std::size_t I>
+    using resource = std::tuple_element_t<I, resources_type>;
+    using large = resource<num_classes>;
+
+  public: // typedefs
+    /// Pointer type
+    using pointer = typename resource<0>::pointer;
+    /// Size type
+    using size_type = typename resource_traits<resource<0>>::size_type;
+
+  private: // constants
+    static constexpr std::array<std::size_t, num_classes + 1> thresholds = {
+      traits<Classes>::threshold...};
+    static constexpr std::array<bool, num_classes + 1> is_size_class = {
+      traits<Classes>::is_size_class...};
+    static constexpr bool valid() noexcept
+    {
+      for (std::size_t c = 0; c != num_classes; ++c)
+      {
+        if (!is_size_class[c] || thresholds[c] == 0 ||
+            (c > 0 && thresholds[c - 1] >= thresholds[c]))
+        {
+          return false;
+        }
+      }
+      return !is_size_class[num_classes];
+    }
+    static_assert(valid());
+    static_assert((is_resource_v<typename traits<Classes>::resource> && ...));
+    static_assert(num_classes <= UINT_LEAST8_MAX);
+    static constexpr std::size_t max_threshold = thresholds[num_classes - 1];
+    static constexpr std::size_t granularity() noexcept
+    {
+      std::size_t g = 0;
+      for (std::size_t c = 0; c != num_classes; ++c)
+      {
+        g = std::gcd(g, thresholds[c]);
+      }
+      return g;
+    }
+    static constexpr std::size_t grain = granularity();
+    static constexpr bool by_grain = max_threshold / grain < max_table_size;
+    /// If `by_grain` entry `k` is the size class of sizes in (`(k - 1) * grain`, `k * grain`].
+    /// Otherwise entry `b` is the smallest size class of sizes with `b` bits.
+    static constexpr auto make_table() noexcept
+    {
+      if constexpr (by_grain)
+      {
+        std::array<uint_least8_t, max_threshold / grain + 1> table = {};
+        std::size_t c = 0;
+        for (std::size_t k = 0; k != table.size(); ++k)
+        {
+          if (k * grain > thresholds[c])
+          {
+            ++c;
+          }
+          table[k] = static_cast<uint_least8_t>(c);
+        }
+        return table;
+      }
+      else
+      {
+        std::array<uint_least8_t, detail::word_bits + 1> table = {};
+        std::size_t c = 0;
+        for (std::size_t b = 1; b != table.size(); ++b)
+        {
+          while (c != num_classes && thresholds[c] < std::size_t(1) << (b - 1))
+          {
+            ++c;
+          }
+          table[b] = static_cast<uint_least8_t>(c);
+        }
+        return table;
+      }
+    }
+    static constexpr auto table = make_table();
+
+  private: // dispatch
+    static constexpr bool all_owners = (is_owner_v<typename traits<Classes>::resource> && ...);
+    using deallocate_result = std::conditional_t<all_owners, bool, void>;
+    /// Expands to a comparison of `c` against every class index, which the compiler turns into a
+    /// jump table with the calls inlined.
+    template<std::size_t... I>
+    pointer allocate_at(
+      std::size_t c, size_type size, size_type alignment, std::index_sequence<I...>) noexcept
+    {
+      pointer ptr = nullptr;
+      ((c == I && ((ptr = std::get<I>(resources).allocate(size, alignment)), true)) || ...);
+      return ptr;
+    }
+    template<std::size_t... I>
+    deallocate_result deallocate_at(std::size_t c,
+      pointer ptr,
+      size_type size,
+      size_type alignment,
+      std::index_sequence<I...>) noexcept
+    {
+      if constexpr (all_owners)
+      {
+        bool owned = false;
+        ((c == I && ((owned = owner_traits<resource<I>>::deallocate(
+                        std::get<I>(resources), ptr, size, alignment)),
+                       true)) ||
+          ...);
+        return owned;
+      }
+      else
+      {
+        ((c == I && (std::get<I>(resources).deallocate(ptr, size, alignment), true)) || ...);
+      }
+    }
+    using indexes = std::make_index_sequence<num_classes + 1>;
+
+  public: // capacity
+    /// @returns The maximum allocation size supported. This is `Large::max_size()`.
+    static constexpr size_type max_size() noexcept
+    {
+      return resource_traits<large>::max_size();
+    }
+
+  public: // modifiers
+    /// Calls `allocate` of the resource of the size class of `size`.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`.
+    ///
+    /// @pre `size <= max_size()`
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      return allocate_at(class_of(size), size, alignment, indexes());
+    }
+    /// Calls `deallocate` of the resource of the size class of `size`.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param size Corresponding argument to call to `allocate`.
+    /// @param alignment Corresponding argument to call to `allocate`.
+    ///
+    /// @returns `true` If every resource is an owner and the resource of the size class owns `ptr`.
+    /// @returns `false` If every resource is an owner and the resource of the size class doesn't
+    /// own `ptr`.
+    deallocate_result deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      return deallocate_at(class_of(size), ptr, size, alignment, indexes());
+    }
+
+  public: // observers
+    /// Checks whether or not `ptr` is owned by any of the resources. Only declared if every
+    /// resource is an owner.
+    ///
+    /// @param ptr Pointer to memory.
+    template<bool B = all_owners, typename = std::enable_if_t<B>>
+    pointer operator[](pointer ptr) noexcept
+    {
+      return std::apply(
+        [ptr](auto &... r) {
+          pointer p = nullptr;
+          ((p = r[ptr]) || ...);
+          return p;
+        },
+        resources);
+    }
+
+  public: // accessors
+    /// @returns Index of the size class of `size`. `num_classes` if `size` is allocated by `Large`.
+    /// * Complexity `O(1)`, or `O(thresholds with as many bits as size)` if not `by_grain`
+    static std::size_t class_of(size_type size) noexcept
+    {
+      if (size > max_threshold)
+      {
+        return num_classes;
+      }
+      if constexpr (by_grain)
+      {
+        return table[(size + (grain - 1)) / grain];
+      }
+      else
+      {
+        std::size_t c =
+          table[detail::word_bits - detail::countl_zero(static_cast<detail::word>(size))];
+        while (size > thresholds[c])
+        {
+          ++c;
+        }
+        return c;
+      }
+    }
+    /// @returns Reference to the resource of size class `I`, or `Large` if `I == num_classes`.
+    template<std::size_t I>
+    resource<I> & get() noexcept
+    {
+      return std::get<I>(resources);
+    }
+    /// @returns Reference to `Large`.
+    large & get_large() noexcept
+    {
+      return std::get<num_classes>(resources);
+    }
+
+  private: // variables
+    resources_type resources;
+  };
+}
\ No newline at end of file
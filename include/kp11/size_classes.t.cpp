@@ -0,0 +1,113 @@
+#include "size_classes.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "local.h" // local
+#include "pool.h" // pool
+#include "traits.h" // is_resource_v, is_owner_v
+
+#include <catch.hpp>
+
+using namespace kp11;
+
+using class16_t = free_block<64, 16, 1, pool<4>, local<64, 16>>; // 16 byte blocks
+using class32_t = free_block<128, 16, 1, pool<4>, local<128, 16>>; // 32 byte blocks
+using class80_t = free_block<320, 16, 1, pool<4>, local<320, 16>>; // 80 byte blocks
+using large_t = local<1024, 16>;
+using resource_t = size_classes<size_class<16, class16_t>,
+  size_class<32, class32_t>,
+  size_class<80, class80_t>,
+  large_t>;
+
+TEST_CASE("max_size", "[max_size]")
+{
+  REQUIRE(resource_t::max_size() == large_t::max_size());
+}
+TEST_CASE("class_of", "[class_of]")
+{
+  REQUIRE(resource_t::num_classes == 3);
+  REQUIRE(resource_t::class_of(0) == 0);
+  REQUIRE(resource_t::class_of(1) == 0);
+  REQUIRE(resource_t::class_of(16) == 0);
+  REQUIRE(resource_t::class_of(17) == 1);
+  REQUIRE(resource_t::class_of(32) == 1);
+  REQUIRE(resource_t::class_of(33) == 2);
+  REQUIRE(resource_t::class_of(48) == 2);
+  REQUIRE(resource_t::class_of(80) == 2);
+  REQUIRE(resource_t::class_of(81) == 3);
+  REQUIRE(resource_t::class_of(1024) == 3);
+}
+TEST_CASE("class_of large thresholds", "[class_of]")
+{
+  // A table by multiples of 8 would have more than max_table_size entries.
+  using m = size_classes<size_class<24, heap>,
+    size_class<40, heap>,
+    size_class<48, heap>,
+    size_class<1 << 20, heap>,
+    heap>;
+  REQUIRE(m::class_of(0) == 0);
+  REQUIRE(m::class_of(1) == 0);
+  REQUIRE(m::class_of(24) == 0);
+  REQUIRE(m::class_of(25) == 1);
+  REQUIRE(m::class_of(32) == 1);
+  REQUIRE(m::class_of(40) == 1);
+  REQUIRE(m::class_of(41) == 2);
+  REQUIRE(m::class_of(48) == 2);
+  REQUIRE(m::class_of(49) == 3);
+  REQUIRE(m::class_of(1 << 19) == 3);
+  REQUIRE(m::class_of(1 << 20) == 3);
+  REQUIRE(m::class_of((1 << 20) + 1) == 4);
+}
+TEST_CASE("accessor", "[accessor]")
+{
+  resource_t m;
+  [[maybe_unused]] class16_t & a = m.get<0>();
+  [[maybe_unused]] class80_t & b = m.get<2>();
+  [[maybe_unused]] large_t & c = m.get<3>();
+  REQUIRE(&m.get_large() == &c);
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  resource_t m;
+  auto a = m.allocate(8, 16);
+  REQUIRE(m.get<0>()[a] == a);
+  auto b = m.allocate(32, 16);
+  REQUIRE(m.get<1>()[b] == b);
+  auto c = m.allocate(64, 16);
+  REQUIRE(m.get<2>()[c] == c);
+  auto d = m.allocate(512, 16);
+  REQUIRE(m.get_large()[d] == d);
+  REQUIRE(m[a] == a);
+  REQUIRE(m[b] == b);
+  REQUIRE(m[c] == c);
+  REQUIRE(m[d] == d);
+  int x;
+  REQUIRE(m[&x] == nullptr);
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  SECTION("owners")
+  {
+    resource_t m;
+    auto a = m.allocate(24, 16);
+    REQUIRE(m.deallocate(a, 24, 16) == true);
+    REQUIRE(m.allocate(24, 16) == a);
+    auto b = m.allocate(8, 16);
+    REQUIRE(m.deallocate(b, 24, 16) == false);
+  }
+  SECTION("not owners")
+  {
+    size_classes<size_class<16, class16_t>, heap> m;
+    auto a = m.allocate(16, 16);
+    auto b = m.allocate(128, 16);
+    REQUIRE(m.get<0>()[a] == a);
+    m.deallocate(a, 16, 16);
+    m.deallocate(b, 128, 16);
+  }
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_owner_v<resource_t> == true);
+  REQUIRE(is_resource_v<size_classes<size_class<16, class16_t>, heap>> == true);
+  REQUIRE(is_owner_v<size_classes<size_class<16, class16_t>, heap>> == false);
+}
\ No newline at end of file
@@ -37,6 +37,12 @@ namespace kp11
     {
       return size();
     }
+    /// @returns Largest `n` that `allocate(n)` would currently succeed with, which is every index
+    /// past the current index.
+    size_type largest_free_run() const noexcept
+    {
+      return size() - index;
+    }
 
   public: // modifiers
     /// Increases our index by `n` and returns the previous index.
@@ -82,6 +88,52 @@ namespace kp11
         index = i;
       }
     }
+    /// Grow [`i`, `i + old_n`) to [`i`, `i + new_n`) if it is the most recent allocation and
+    /// there are enough indexes past it.
+    /// * Complexity `O(1)`
+    ///
+    /// @param i Returned by a call to `allocate`.
+    /// @param old_n Corresponding parameter in the call to `allocate`.
+    /// @param new_n Number of indexes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false`
+    ///
+    /// @pre `0 < old_n <= new_n`
+    bool expand(size_type i, size_type old_n, size_type new_n) noexcept
+    {
+      assert(0 < old_n && old_n <= new_n);
+      assert(i < index);
+      if (i + old_n == index && size() - i >= new_n)
+      {
+        index = i + new_n;
+        return true;
+      }
+      return false;
+    }
+    /// Shrink [`i`, `i + old_n`) to [`i`, `i + new_n`) if it is the most recent allocation. Like
+    /// `deallocate` the indexes can't be recovered otherwise.
+    /// * Complexity `O(1)`
+    ///
+    /// @param i Returned by a call to `allocate`.
+    /// @param old_n Corresponding parameter in the call to `allocate`.
+    /// @param new_n Number of indexes wanted.
+    ///
+    /// @returns (success) `true`
+    /// @returns (failure) `false` and nothing was changed.
+    ///
+    /// @pre `0 < new_n <= old_n`
+    bool shrink(size_type i, size_type old_n, size_type new_n) noexcept
+    {
+      assert(0 < new_n && new_n <= old_n);
+      assert(i < index);
+      if (i + old_n == index)
+      {
+        index = i + new_n;
+        return true;
+      }
+      return false;
+    }
 
   private: // variables
     /// Current index.
@@ -66,6 +66,42 @@ TEST_CASE("deallocate", "[deallocate]")
     REQUIRE(c != a);
   }
 }
+TEST_CASE("largest_free_run", "[largest_free_run]")
+{
+  stack<10> m;
+  REQUIRE(m.largest_free_run() == 10);
+  auto a = m.allocate(3);
+  m.allocate(2);
+  REQUIRE(m.largest_free_run() == 5);
+  m.deallocate(a, 3);
+  REQUIRE(m.largest_free_run() == 5);
+}
+TEST_CASE("expand/shrink", "[expand/shrink]")
+{
+  stack<10> m;
+  auto a = m.allocate(2);
+  auto b = m.allocate(3);
+  SECTION("top")
+  {
+    REQUIRE(m.expand(b, 3, 8) == true);
+    REQUIRE(m.count() == 10);
+    REQUIRE(m.expand(b, 8, 9) == false);
+    REQUIRE(m.shrink(b, 8, 1) == true);
+    REQUIRE(m.count() == 3);
+    m.deallocate(b, 1);
+    REQUIRE(m.count() == 2);
+  }
+  SECTION("not top")
+  {
+    REQUIRE(m.expand(a, 2, 3) == false);
+    REQUIRE(m.shrink(a, 2, 1) == false);
+    REQUIRE(m.count() == 5);
+    // The indexes are still recovered when deallocated with the original size.
+    m.deallocate(b, 3);
+    m.deallocate(a, 2);
+    REQUIRE(m.count() == 0);
+  }
+}
 TEST_CASE("traits", "[traits]")
 {
   REQUIRE(is_marker_v<stack<10>> == true);
@@ -0,0 +1,31 @@
+#include "stats.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "pool.h" // pool
+
+#include <benchmark/benchmark.h>
+
+using namespace kp11;
+
+namespace
+{
+  using resource_t = free_block<64 * 256, 64, 1, pool<256>, heap>;
+}
+
+// The difference from the bare resource is the cost of counting.
+template<typename Resource>
+static void stats_pair(benchmark::State & state)
+{
+  static Resource r;
+  for (auto _ : state)
+  {
+    auto p = r.allocate(64, 64);
+    benchmark::DoNotOptimize(p);
+    r.deallocate(p, 64, 64);
+  }
+}
+BENCHMARK_TEMPLATE(stats_pair, resource_t);
+BENCHMARK_TEMPLATE(stats_pair, stats<resource_t, no_counters>);
+BENCHMARK_TEMPLATE(stats_pair, stats<resource_t, plain_counters>);
+BENCHMARK_TEMPLATE(stats_pair, stats<resource_t>);
\ No newline at end of file
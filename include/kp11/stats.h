@@ -0,0 +1,337 @@
+#pragma once
+
+#include "detail/bit.h" // word_bits, countl_zero
+#include "traits.h" // is_resource_v, resource_traits, is_owner_v, owner_traits
+
+#include <array> // array
+#include <atomic> // atomic, memory_order_relaxed
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <type_traits> // enable_if_t, is_same_v
+
+namespace kp11
+{
+  namespace stats_detail
+  {
+    /// Number of buckets in the size histogram.
+    inline constexpr std::size_t num_buckets = detail::word_bits + 1;
+
+    /// @private
+    template<typename T>
+    void add(T & x, std::uint64_t n) noexcept
+    {
+      if constexpr (std::is_same_v<T, std::uint64_t>)
+      {
+        x += n;
+      }
+      else
+      {
+        x.fetch_add(n, std::memory_order_relaxed);
+      }
+    }
+    /// @private
+    template<typename T>
+    void sub(T & x, std::uint64_t n) noexcept
+    {
+      if constexpr (std::is_same_v<T, std::uint64_t>)
+      {
+        x -= n;
+      }
+      else
+      {
+        x.fetch_sub(n, std::memory_order_relaxed);
+      }
+    }
+    /// @private
+    template<typename T>
+    std::uint64_t load(T const & x) noexcept
+    {
+      if constexpr (std::is_same_v<T, std::uint64_t>)
+      {
+        return x;
+      }
+      else
+      {
+        return x.load(std::memory_order_relaxed);
+      }
+    }
+
+    /// @private
+    /// The number of allocations is the sum of the histogram so that it doesn't need its own
+    /// counter.
+    template<typename T>
+    class basic_counters
+    {
+    public: // modifiers
+      void on_allocate(std::uint64_t size) noexcept
+      {
+        add(histogram[bucket(size)], 1);
+        if constexpr (std::is_same_v<T, std::uint64_t>)
+        {
+          bytes_in_use += size;
+          high_water = bytes_in_use > high_water ? bytes_in_use : high_water;
+        }
+        else
+        {
+          auto const now = bytes_in_use.fetch_add(size, std::memory_order_relaxed) + size;
+          auto prev = high_water.load(std::memory_order_relaxed);
+          while (prev < now &&
+                 !high_water.compare_exchange_weak(prev, now, std::memory_order_relaxed))
+          {
+          }
+        }
+      }
+      void on_failure() noexcept
+      {
+        add(failures, 1);
+      }
+      void on_deallocate(std::uint64_t size) noexcept
+      {
+        add(deallocations, 1);
+        sub(bytes_in_use, size);
+      }
+
+    public: // observers
+      std::uint64_t get_allocations() const noexcept
+      {
+        std::uint64_t n = 0;
+        for (auto const & x : histogram)
+        {
+          n += load(x);
+        }
+        return n;
+      }
+      std::uint64_t get_deallocations() const noexcept
+      {
+        return load(deallocations);
+      }
+      std::uint64_t get_failures() const noexcept
+      {
+        return load(failures);
+      }
+      std::uint64_t get_bytes() const noexcept
+      {
+        return load(bytes_in_use);
+      }
+      std::uint64_t get_peak() const noexcept
+      {
+        return load(high_water);
+      }
+      std::uint64_t get_histogram(std::size_t i) const noexcept
+      {
+        return load(histogram[i]);
+      }
+
+    private: // helpers
+      static std::size_t bucket(std::uint64_t size) noexcept
+      {
+        return detail::word_bits - detail::countl_zero(size);
+      }
+
+    private: // variables
+      T deallocations = 0;
+      T failures = 0;
+      T bytes_in_use = 0;
+      T high_water = 0;
+      std::array<T, num_buckets> histogram = {};
+    };
+  }
+
+  /// Counter policy of `stats` that uses relaxed atomics, so that it is as thread safe as the
+  /// resource. Each counted call costs a couple of locked instructions.
+  class atomic_counters : public stats_detail::basic_counters<std::atomic<std::uint64_t>>
+  {
+  };
+  /// Counter policy of `stats` that uses plain integers. Use it when calls are already serialized
+  /// e.g. inside of `synchronized` or `thread_cache`.
+  class plain_counters : public stats_detail::basic_counters<std::uint64_t>
+  {
+  };
+  /// Counter policy of `stats` that has no state and counts nothing, so that statistics can be
+  /// turned off in a build without changing the composition.
+  class no_counters
+  {
+  public: // modifiers
+    void on_allocate(std::uint64_t) noexcept
+    {
+    }
+    void on_failure() noexcept
+    {
+    }
+    void on_deallocate(std::uint64_t) noexcept
+    {
+    }
+
+  public: // observers
+    std::uint64_t get_allocations() const noexcept
+    {
+      return 0;
+    }
+    std::uint64_t get_deallocations() const noexcept
+    {
+      return 0;
+    }
+    std::uint64_t get_failures() const noexcept
+    {
+      return 0;
+    }
+    std::uint64_t get_bytes() const noexcept
+    {
+      return 0;
+    }
+    std::uint64_t get_peak() const noexcept
+    {
+      return 0;
+    }
+    std::uint64_t get_histogram(std::size_t) const noexcept
+    {
+      return 0;
+    }
+  };
+
+  /// @brief Counts the calls to `Resource`, the bytes in use and the sizes requested.
+  ///
+  /// With `no_counters` every call is forwarded directly and we are the same size as `Resource`.
+  ///
+  /// If `Resource` is an owner then so are we, so that we can be anywhere in a `fallback` or
+  /// `segregator`.
+  ///
+  /// @tparam Resource Meets the `Resource` concept.
+  /// @tparam Counters `atomic_counters`, `plain_counters` or `no_counters`.
+  template<typename Resource, typename Counters = atomic_counters>
+  class stats : private Counters
+  {
+    static_assert(is_resource_v<Resource>);
+
+  private: // typedefs
+    using counters = Counters;
+
+  public: // typedefs
+    /// Pointer type
+    using pointer = typename Resource::pointer;
+    /// Size type
+    using size_type = typename resource_traits<Resource>::size_type;
+
+  public: // constants
+    /// Number of buckets in the size histogram.
+    static constexpr std::size_t num_buckets = stats_detail::num_buckets;
+
+  public: // capacity
+    /// @returns The maximum allocation size supported. This is `Resource::max_size()`.
+    static constexpr size_type max_size() noexcept
+    {
+      return resource_traits<Resource>::max_size();
+    }
+
+  public: // modifiers
+    /// Call `Resource::allocate` and count it.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @pre `size <= max_size()`
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      auto ptr = resource.allocate(size, alignment);
+      if (ptr)
+      {
+        counters::on_allocate(static_cast<std::uint64_t>(size));
+      }
+      else
+      {
+        counters::on_failure();
+      }
+      return ptr;
+    }
+    /// Call `Resource::deallocate` and count it.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param size Corresponding argument to call to `allocate`.
+    /// @param alignment Corresponding argument to call to `allocate`.
+    ///
+    /// @returns `true` If `Resource` is an owner and it owns `ptr`.
+    /// @returns `false` If `Resource` is an owner and it doesn't own `ptr`. Nothing is counted.
+    auto deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      if constexpr (is_owner_v<Resource>)
+      {
+        auto const owned = owner_traits<Resource>::deallocate(resource, ptr, size, alignment);
+        if (owned)
+        {
+          counters::on_deallocate(static_cast<std::uint64_t>(size));
+        }
+        return owned;
+      }
+      else
+      {
+        resource.deallocate(ptr, size, alignment);
+        counters::on_deallocate(static_cast<std::uint64_t>(size));
+      }
+    }
+
+  public: // observers
+    /// Call `Resource::operator[]`. Only declared if `Resource` is an owner so that we aren't
+    /// detected as an owner otherwise.
+    ///
+    /// @param ptr Pointer to memory.
+    template<typename R = Resource, typename = std::enable_if_t<is_owner_v<R>>>
+    pointer operator[](pointer ptr) noexcept
+    {
+      return resource[ptr];
+    }
+    /// @returns Number of successful calls to `allocate`.
+    std::uint64_t allocations() const noexcept
+    {
+      return counters::get_allocations();
+    }
+    /// @returns Number of calls to `deallocate`, not counting pointers that aren't owned.
+    std::uint64_t deallocations() const noexcept
+    {
+      return counters::get_deallocations();
+    }
+    /// @returns Number of calls to `allocate` that returned `nullptr`.
+    std::uint64_t failures() const noexcept
+    {
+      return counters::get_failures();
+    }
+    /// @returns Number of requested bytes currently allocated.
+    std::uint64_t bytes() const noexcept
+    {
+      return counters::get_bytes();
+    }
+    /// @returns Greatest number of requested bytes allocated at any one time.
+    std::uint64_t peak() const noexcept
+    {
+      return counters::get_peak();
+    }
+    /// @returns Number of successful calls to `allocate` with a size in [`2^(i-1)`, `2^i`). Bucket
+    /// `0` counts a size of `0`.
+    ///
+    /// @pre `i < num_buckets`
+    std::uint64_t histogram(std::size_t i) const noexcept
+    {
+      assert(i < num_buckets);
+      return counters::get_histogram(i);
+    }
+
+  public: // accessors
+    /// @returns Reference to `Resource`.
+    Resource & get_resource() noexcept
+    {
+      return resource;
+    }
+    /// @returns Reference to `Resource`.
+    Resource const & get_resource() const noexcept
+    {
+      return resource;
+    }
+
+  private: // variables
+    Resource resource;
+  };
+}
\ No newline at end of file
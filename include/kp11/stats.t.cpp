@@ -0,0 +1,146 @@
+#include "stats.h"
+
+#include "fallback.h" // fallback
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "local.h" // local
+#include "stack.h" // stack
+#include "traits.h" // is_resource_v, is_owner_v
+
+#include <catch.hpp>
+
+#include <thread> // thread
+#include <vector> // vector
+
+using namespace kp11;
+
+using owner_t = free_block<128, 4, 1, stack<4>, local<128, 4>>;
+
+TEST_CASE("max_size", "[max_size]")
+{
+  REQUIRE(stats<owner_t>::max_size() == owner_t::max_size());
+}
+TEST_CASE("accessor", "[accessor]")
+{
+  stats<owner_t> m;
+  [[maybe_unused]] owner_t & a = m.get_resource();
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  stats<owner_t> m;
+  auto a = m.allocate(32, 4);
+  REQUIRE(m[a] == a);
+  REQUIRE(m.allocations() == 1);
+  REQUIRE(m.bytes() == 32);
+  REQUIRE(m.peak() == 32);
+  REQUIRE(m.histogram(6) == 1);
+  m.allocate(64, 4);
+  REQUIRE(m.bytes() == 96);
+  REQUIRE(m.histogram(7) == 1);
+  SECTION("failure")
+  {
+    REQUIRE(m.allocate(64, 4) == nullptr);
+    REQUIRE(m.failures() == 1);
+    REQUIRE(m.allocations() == 2);
+    REQUIRE(m.bytes() == 96);
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  SECTION("owner")
+  {
+    stats<owner_t> m;
+    auto a = m.allocate(32, 4);
+    auto b = m.allocate(64, 4);
+    REQUIRE(m.deallocate(b, 64, 4) == true);
+    REQUIRE(m.deallocations() == 1);
+    REQUIRE(m.bytes() == 32);
+    REQUIRE(m.peak() == 96);
+    int x;
+    REQUIRE(m.deallocate(&x, 32, 4) == false);
+    REQUIRE(m.deallocations() == 1);
+    REQUIRE(m.deallocate(a, 32, 4) == true);
+    REQUIRE(m.bytes() == 0);
+  }
+  SECTION("not an owner")
+  {
+    stats<heap> m;
+    auto a = m.allocate(32, 4);
+    m.deallocate(a, 32, 4);
+    REQUIRE(m.deallocations() == 1);
+    REQUIRE(m.bytes() == 0);
+  }
+}
+TEST_CASE("histogram", "[histogram]")
+{
+  stats<heap> m;
+  for (std::size_t size : {0, 1, 2, 3, 4, 7, 8})
+  {
+    m.deallocate(m.allocate(size, 1), size, 1);
+  }
+  REQUIRE(m.histogram(0) == 1);
+  REQUIRE(m.histogram(1) == 1);
+  REQUIRE(m.histogram(2) == 2);
+  REQUIRE(m.histogram(3) == 2);
+  REQUIRE(m.histogram(4) == 1);
+  REQUIRE(m.histogram(stats<heap>::num_buckets - 1) == 0);
+}
+TEST_CASE("plain_counters", "[plain_counters]")
+{
+  stats<owner_t, plain_counters> m;
+  auto a = m.allocate(32, 4);
+  auto b = m.allocate(64, 4);
+  REQUIRE(m.deallocate(a, 32, 4) == true);
+  REQUIRE(m.allocations() == 2);
+  REQUIRE(m.deallocations() == 1);
+  REQUIRE(m.bytes() == 64);
+  REQUIRE(m.peak() == 96);
+  REQUIRE(m.histogram(7) == 1);
+  REQUIRE(m.allocate(128, 4) == nullptr);
+  REQUIRE(m.failures() == 1);
+  m.deallocate(b, 64, 4);
+}
+TEST_CASE("no_counters", "[no_counters]")
+{
+  stats<owner_t, no_counters> m;
+  REQUIRE(sizeof(m) == sizeof(owner_t));
+  auto a = m.allocate(32, 4);
+  REQUIRE(m[a] == a);
+  REQUIRE(m.deallocate(a, 32, 4) == true);
+  REQUIRE(m.allocations() == 0);
+  REQUIRE(m.deallocations() == 0);
+  REQUIRE(m.bytes() == 0);
+  REQUIRE(m.peak() == 0);
+  REQUIRE(m.histogram(6) == 0);
+}
+TEST_CASE("threads", "[threads]")
+{
+  stats<heap> m;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&m] {
+      for (int i = 0; i < 1000; ++i)
+      {
+        m.deallocate(m.allocate(16, 16), 16, 16);
+      }
+    });
+  }
+  for (auto & t : threads)
+  {
+    t.join();
+  }
+  REQUIRE(m.allocations() == 4000);
+  REQUIRE(m.deallocations() == 4000);
+  REQUIRE(m.bytes() == 0);
+  REQUIRE(m.peak() >= 16);
+  REQUIRE(m.peak() <= 64);
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_owner_v<stats<owner_t>> == true);
+  REQUIRE(is_owner_v<stats<owner_t, no_counters>> == true);
+  REQUIRE(is_resource_v<stats<heap>> == true);
+  REQUIRE(is_owner_v<stats<heap>> == false);
+  REQUIRE(is_owner_v<fallback<stats<owner_t>, heap>> == true);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "synchronized.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "pool.h" // pool
+
+#include <benchmark/benchmark.h>
+
+#include <mutex> // mutex
+
+using namespace kp11;
+
+namespace
+{
+  using resource = free_block<64 * 1024, 16, 16, pool<1024>, heap>;
+}
+
+// Every thread allocates and deallocates a few blocks from one shared resource.
+template<typename Lock>
+static void synchronized_contention(benchmark::State & state)
+{
+  static synchronized<resource, Lock> r;
+  void * ptrs[4];
+  for (auto _ : state)
+  {
+    for (auto & p : ptrs)
+    {
+      p = r.allocate(64, 16);
+    }
+    for (auto p : ptrs)
+    {
+      r.deallocate(p, 64, 16);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(ptrs));
+}
+BENCHMARK_TEMPLATE(synchronized_contention, std::mutex)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(synchronized_contention, spin_lock)->ThreadRange(1, 16)->UseRealTime();
+#if defined(__linux__)
+BENCHMARK_TEMPLATE(synchronized_contention, futex_lock)->ThreadRange(1, 16)->UseRealTime();
+#endif
\ No newline at end of file
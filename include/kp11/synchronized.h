@@ -0,0 +1,248 @@
+#pragma once
+
+#include "traits.h" // is_resource_v, resource_traits, is_owner_v, owner_traits
+
+#include <atomic> // atomic, memory_order_relaxed, memory_order_acquire, memory_order_release
+#include <cassert> // assert
+#include <mutex> // mutex, lock_guard
+#include <thread> // this_thread::yield
+#include <type_traits> // enable_if_t
+#if defined(_MSC_VER)
+#  include <intrin.h> // _mm_pause
+#endif
+#if defined(__linux__)
+#  include <linux/futex.h> // FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#  include <sys/syscall.h> // SYS_futex
+#  include <unistd.h> // syscall
+#endif
+
+namespace kp11
+{
+  namespace synchronized_detail
+  {
+    /// Hint to the processor that we are in a spin loop.
+    inline void pause() noexcept
+    {
+#if defined(_MSC_VER)
+      _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#elif defined(__aarch64__)
+      asm volatile("yield");
+#endif
+    }
+    /// Number of times a lock spins before it gives up the processor.
+    inline constexpr int spin_count = 64;
+  }
+
+  /// @brief Test and test and set spin lock. Meets the `Lockable` requirements.
+  ///
+  /// Waiting threads spin on a plain load, so that the cache line is only written when the lock
+  /// looks free, and yield after every `spin_count` spins in case the owner isn't running.
+  class spin_lock
+  {
+  public: // modifiers
+    void lock() noexcept
+    {
+      while (locked.exchange(true, std::memory_order_acquire))
+      {
+        for (int i = 0; locked.load(std::memory_order_relaxed); ++i)
+        {
+          if (i == synchronized_detail::spin_count)
+          {
+            std::this_thread::yield();
+            i = 0;
+          }
+          synchronized_detail::pause();
+        }
+      }
+    }
+    bool try_lock() noexcept
+    {
+      return !locked.load(std::memory_order_relaxed) &&
+             !locked.exchange(true, std::memory_order_acquire);
+    }
+    void unlock() noexcept
+    {
+      locked.store(false, std::memory_order_release);
+    }
+
+  private: // variables
+    std::atomic<bool> locked = false;
+  };
+
+#if defined(__linux__)
+  /// @brief Adaptive lock that spins for a while and then sleeps on a futex. Meets the `Lockable`
+  /// requirements. Only available on Linux.
+  ///
+  /// The state is `0` when unlocked, `1` when locked and `2` when locked and there may be
+  /// sleeping threads, so an `unlock` without contention doesn't need a system call.
+  class futex_lock
+  {
+    static_assert(sizeof(std::atomic<int>) == sizeof(int));
+    static_assert(std::atomic<int>::is_always_lock_free);
+
+  public: // modifiers
+    void lock() noexcept
+    {
+      if (try_lock())
+      {
+        return;
+      }
+      for (int i = 0; i != synchronized_detail::spin_count; ++i)
+      {
+        synchronized_detail::pause();
+        if (state.load(std::memory_order_relaxed) == 0 && try_lock())
+        {
+          return;
+        }
+      }
+      while (state.exchange(2, std::memory_order_acquire) != 0)
+      {
+        syscall(SYS_futex, address(), FUTEX_WAIT_PRIVATE, 2, nullptr, nullptr, 0);
+      }
+    }
+    bool try_lock() noexcept
+    {
+      int expected = 0;
+      return state.compare_exchange_strong(
+        expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    void unlock() noexcept
+    {
+      if (state.exchange(0, std::memory_order_release) == 2)
+      {
+        syscall(SYS_futex, address(), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+      }
+    }
+
+  private: // helpers
+    int * address() noexcept
+    {
+      return reinterpret_cast<int *>(&state);
+    }
+
+  private: // variables
+    std::atomic<int> state = 0;
+  };
+#endif
+
+  /// @brief Makes `Resource` thread safe by locking `Lock` around every call to it.
+  ///
+  /// If `Resource` is an owner then so are we, so that we can still be used as the `Primary` of a
+  /// `fallback` or the `Small` or `Large` of a `segregator`.
+  ///
+  /// @tparam Resource Meets the `Resource` concept.
+  /// @tparam Lock Meets the `BasicLockable` requirements e.g. `std::mutex`, `spin_lock` or
+  /// `futex_lock`.
+  template<typename Resource, typename Lock = std::mutex>
+  class synchronized
+  {
+    static_assert(is_resource_v<Resource>);
+
+  public: // typedefs
+    /// Pointer type
+    using pointer = typename Resource::pointer;
+    /// Size type
+    using size_type = typename resource_traits<Resource>::size_type;
+
+  public: // capacity
+    /// @returns The maximum allocation size supported. This is `Resource::max_size()`.
+    static constexpr size_type max_size() noexcept
+    {
+      return resource_traits<Resource>::max_size();
+    }
+
+  public: // modifiers
+    /// Call `Resource::allocate` under the lock.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment of memory to allocate.
+    ///
+    /// @pre `size <= max_size()`
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      std::lock_guard<Lock> guard(lock);
+      return resource.allocate(size, alignment);
+    }
+    /// Call `Resource::deallocate` under the lock.
+    ///
+    /// @param ptr Pointer to the beginning of memory returned by a call to `allocate`.
+    /// @param size Corresponding argument to call to `allocate`.
+    /// @param alignment Corresponding argument to call to `allocate`.
+    ///
+    /// @returns `true` If `Resource` is an owner and it owns `ptr`.
+    /// @returns `false` If `Resource` is an owner and it doesn't own `ptr`.
+    auto deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      std::lock_guard<Lock> guard(lock);
+      if constexpr (is_owner_v<Resource>)
+      {
+        return owner_traits<Resource>::deallocate(resource, ptr, size, alignment);
+      }
+      else
+      {
+        resource.deallocate(ptr, size, alignment);
+      }
+    }
+
+    /// Call `resource_traits<Resource>::allocate_bulk` under a single lock.
+    ///
+    /// @param size Size in bytes of each allocation.
+    /// @param alignment Alignment of each allocation.
+    /// @param n Number of allocations.
+    /// @param out Written with the pointer to each allocation.
+    ///
+    /// @returns Number of allocations written to the front of `out`.
+    size_type allocate_bulk(
+      size_type size, size_type alignment, size_type n, pointer * out) noexcept
+    {
+      std::lock_guard<Lock> guard(lock);
+      return resource_traits<Resource>::allocate_bulk(resource, size, alignment, n, out);
+    }
+    /// Call `resource_traits<Resource>::deallocate_bulk` under a single lock.
+    ///
+    /// @param ptrs Pointers returned by calls to `allocate` or `allocate_bulk`.
+    /// @param size Corresponding argument to the calls.
+    /// @param alignment Corresponding argument to the calls.
+    /// @param n Number of pointers.
+    void deallocate_bulk(
+      pointer const * ptrs, size_type size, size_type alignment, size_type n) noexcept
+    {
+      std::lock_guard<Lock> guard(lock);
+      resource_traits<Resource>::deallocate_bulk(resource, ptrs, size, alignment, n);
+    }
+
+  public: // observers
+    /// Call `Resource::operator[]` under the lock. Only declared if `Resource` is an owner so
+    /// that we aren't detected as an owner otherwise.
+    ///
+    /// @param ptr Pointer to memory.
+    template<typename R = Resource, typename = std::enable_if_t<is_owner_v<R>>>
+    pointer operator[](pointer ptr) noexcept
+    {
+      std::lock_guard<Lock> guard(lock);
+      return resource[ptr];
+    }
+
+  public: // accessors
+    /// @returns Reference to `Resource`. Access to it is not synchronized.
+    Resource & get_resource() noexcept
+    {
+      return resource;
+    }
+    /// @returns Reference to `Resource`. Access to it is not synchronized.
+    Resource const & get_resource() const noexcept
+    {
+      return resource;
+    }
+
+  private: // variables
+    Lock lock;
+    Resource resource;
+  };
+}
\ No newline at end of file
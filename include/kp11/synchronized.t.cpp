@@ -0,0 +1,140 @@
+#include "synchronized.h"
+
+#include "bitset.h" // bitset
+#include "fallback.h" // fallback
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "local.h" // local
+#include "segregator.h" // segregator
+#include "stack.h" // stack
+#include "traits.h" // is_resource_v, is_owner_v
+
+#include <catch.hpp>
+
+#include <array> // array
+#include <mutex> // mutex
+#include <thread> // thread
+#include <vector> // vector
+
+using namespace kp11;
+
+using owner_t = free_block<128, 4, 1, stack<4>, local<128, 4>>;
+
+TEST_CASE("max_size", "[max_size]")
+{
+  REQUIRE(synchronized<owner_t>::max_size() == owner_t::max_size());
+  REQUIRE(synchronized<heap>::max_size() == resource_traits<heap>::max_size());
+}
+TEST_CASE("accessor", "[accessor]")
+{
+  synchronized<owner_t> m;
+  [[maybe_unused]] auto & a = m.get_resource();
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  synchronized<owner_t> m;
+  auto a = m.allocate(32, 4);
+  REQUIRE(a != nullptr);
+  REQUIRE(m[a] == a);
+  REQUIRE(m.get_resource()[a] == a);
+  SECTION("failure")
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      REQUIRE(m.allocate(32, 4) != nullptr);
+    }
+    REQUIRE(m.allocate(32, 4) == nullptr);
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  SECTION("owner")
+  {
+    synchronized<owner_t> m;
+    auto a = m.allocate(32, 4);
+    REQUIRE(m.deallocate(a, 32, 4) == true);
+    int x;
+    REQUIRE(m.deallocate(&x, 32, 4) == false);
+    REQUIRE(m.allocate(32, 4) == a);
+  }
+  SECTION("not an owner")
+  {
+    synchronized<heap> m;
+    auto a = m.allocate(32, 4);
+    REQUIRE(a != nullptr);
+    m.deallocate(a, 32, 4);
+  }
+}
+TEST_CASE("bulk", "[bulk]")
+{
+  synchronized<owner_t> m;
+  void * ptrs[5] = {};
+  REQUIRE(m.allocate_bulk(32, 4, 5, ptrs) == 4);
+  REQUIRE(m.allocate(32, 4) == nullptr);
+  m.deallocate_bulk(ptrs, 32, 4, 4);
+  REQUIRE(m.allocate(32, 4) != nullptr);
+}
+TEST_CASE("composes", "[composes]")
+{
+  SECTION("fallback")
+  {
+    fallback<synchronized<owner_t>, heap> m;
+    auto a = m.allocate(128, 4);
+    REQUIRE(m.get_primary()[a] == a);
+    auto b = m.allocate(128, 4);
+    REQUIRE(m.get_primary()[b] == nullptr);
+    m.deallocate(a, 128, 4);
+    m.deallocate(b, 128, 4);
+  }
+  SECTION("segregator")
+  {
+    segregator<32, synchronized<owner_t>, synchronized<local<128, 4>>> m;
+    auto a = m.allocate(32, 4);
+    auto b = m.allocate(64, 4);
+    REQUIRE(m[a] == a);
+    REQUIRE(m[b] == b);
+    REQUIRE(m.deallocate(a, 32, 4) == true);
+    REQUIRE(m.deallocate(b, 64, 4) == true);
+  }
+}
+#if defined(__linux__)
+TEMPLATE_TEST_CASE("threads", "[threads]", std::mutex, spin_lock, futex_lock)
+#else
+TEMPLATE_TEST_CASE("threads", "[threads]", std::mutex, spin_lock)
+#endif
+{
+  constexpr int num_threads = 4;
+  constexpr int num_iterations = 10000;
+  synchronized<free_block<1024, 16, 1, bitset<64>, heap>, TestType> m;
+  std::array<int, num_threads> failures = {};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t] {
+      for (int k = 0; k < num_iterations; ++k)
+      {
+        auto a = m.allocate(16, 16);
+        auto b = m.allocate(32, 16);
+        failures[t] += a == nullptr || b == nullptr;
+        failures[t] += !m.deallocate(b, 32, 16);
+        failures[t] += !m.deallocate(a, 16, 16);
+      }
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  for (auto f : failures)
+  {
+    REQUIRE(f == 0);
+  }
+  REQUIRE(m.get_resource().allocate(1024, 16) != nullptr);
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_owner_v<synchronized<owner_t>> == true);
+  REQUIRE(is_resource_v<synchronized<heap>> == true);
+  REQUIRE(is_owner_v<synchronized<heap>> == false);
+  REQUIRE(is_owner_v<synchronized<owner_t, spin_lock>> == true);
+}
\ No newline at end of file
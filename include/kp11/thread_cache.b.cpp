@@ -0,0 +1,100 @@
+#include "thread_cache.h"
+
+#include "free_block.h" // free_block
+#include "heap.h" // heap
+#include "pool.h" // pool
+
+#include <benchmark/benchmark.h>
+
+#include <array> // array
+#include <atomic> // atomic
+#include <cstddef> // size_t
+#include <mutex> // mutex, lock_guard
+#include <random> // minstd_rand
+
+using namespace kp11;
+
+namespace
+{
+  /// 128 byte blocks.
+  using shared = free_block<128 * 1024, 16, 1024, pool<1024>, heap>;
+
+  /// @private
+  class locked
+  {
+  public:
+    using pointer = typename shared::pointer;
+    using size_type = typename shared::size_type;
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return r.allocate(size, alignment);
+    }
+    void deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      r.deallocate(ptr, size, alignment);
+    }
+
+  private:
+    std::mutex mutex;
+    shared r;
+  };
+
+  using cached = thread_cache<shared, 16, 32, 64, 128>;
+}
+
+// Each thread allocates a handful of blocks and deallocates them in reverse order.
+template<typename Resource>
+static void thread_cache_same_thread(benchmark::State & state)
+{
+  static Resource r;
+  void * ptrs[16];
+  for (auto _ : state)
+  {
+    for (auto & p : ptrs)
+    {
+      p = r.allocate(64, 16);
+    }
+    for (auto i = std::size(ptrs); i--;)
+    {
+      r.deallocate(ptrs[i], 64, 16);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(ptrs));
+}
+BENCHMARK_TEMPLATE(thread_cache_same_thread, cached)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(thread_cache_same_thread, locked)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(thread_cache_same_thread, heap)->ThreadRange(1, 64)->UseRealTime();
+
+// Each allocation is swapped into a random shared slot and whatever was there, usually allocated by
+// another thread, is deallocated.
+template<typename Resource>
+static void thread_cache_producer_consumer(benchmark::State & state)
+{
+  static Resource r;
+  static std::array<std::atomic<void *>, 4096> slots;
+  std::minstd_rand rng(static_cast<unsigned>(state.thread_index()) + 1);
+  for (auto _ : state)
+  {
+    auto p = r.allocate(64, 16);
+    if (auto old = slots[rng() % slots.size()].exchange(p))
+    {
+      r.deallocate(old, 64, 16);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0)
+  {
+    for (auto & slot : slots)
+    {
+      if (auto old = slot.exchange(nullptr))
+      {
+        r.deallocate(old, 64, 16);
+      }
+    }
+  }
+}
+BENCHMARK_TEMPLATE(thread_cache_producer_consumer, cached)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(thread_cache_producer_consumer, locked)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(thread_cache_producer_consumer, heap)->ThreadRange(1, 64)->UseRealTime();
\ No newline at end of file
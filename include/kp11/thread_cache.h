@@ -0,0 +1,299 @@
+#pragma once
+
+#include "traits.h" // is_resource_v, resource_traits
+
+#include <array> // array
+#include <atomic> // atomic, memory_order_relaxed
+#include <cassert> // assert
+#include <cstddef> // size_t, max_align_t
+#include <mutex> // mutex, lock_guard
+
+namespace kp11
+{
+  /// @brief Thread safe front end that caches blocks per thread, per size class, in front of a
+  /// shared `Upstream`.
+  ///
+  /// Requests that fit into one of `SizeClasses` are served from a small cache that belongs to the
+  /// calling thread and so need no lock. An empty cache is refilled with a batch of blocks from
+  /// `Upstream` and a full cache drains a batch of blocks back to `Upstream`, each batch under a
+  /// single lock. Blocks of a size class are interchangeable, so they may be deallocated by any
+  /// thread. Requests that don't fit into a size class go straight to `Upstream` under the lock.
+  ///
+  /// A thread's cache is bound to a single `thread_cache` at a time. Using another `thread_cache`
+  /// of the same type from the same thread drains the cache back to the previous one first. Caches
+  /// are drained when their thread exits and when the `thread_cache` is destroyed.
+  ///
+  /// @tparam Upstream Meets the `Resource` concept. Only ever accessed under a lock.
+  /// @tparam SizeClasses Strictly ascending sizes in bytes of the blocks that are cached.
+  template<typename Upstream, std::size_t... SizeClasses>
+  class thread_cache
+  {
+    static_assert(is_resource_v<Upstream>);
+    static_assert(sizeof...(SizeClasses) > 0);
+
+  public: // typedefs
+    /// Pointer type.
+    using pointer = typename Upstream::pointer;
+    /// Size type.
+    using size_type = typename resource_traits<Upstream>::size_type;
+
+  public: // constants
+    /// Number of size classes.
+    static constexpr std::size_t num_classes = sizeof...(SizeClasses);
+    /// Maximum number of blocks cached per thread per size class.
+    static constexpr std::size_t cache_size = 32;
+    /// Number of blocks moved between a cache and `Upstream` at a time.
+    static constexpr std::size_t batch_size = cache_size / 2;
+
+  private: // constants
+    static constexpr std::array<std::size_t, num_classes> class_sizes = {SizeClasses...};
+    static constexpr bool ascending() noexcept
+    {
+      for (std::size_t c = 1; c < num_classes; ++c)
+      {
+        if (class_sizes[c - 1] >= class_sizes[c])
+        {
+          return false;
+        }
+      }
+      return class_sizes[0] > 0;
+    }
+    static_assert(ascending());
+    /// Blocks of a size class are allocated from `Upstream` with the largest power of two that
+    /// divides its size, up to `alignof(std::max_align_t)`.
+    static constexpr std::size_t class_alignment(std::size_t c) noexcept
+    {
+      auto const a = class_sizes[c] & (~class_sizes[c] + 1);
+      return a < alignof(std::max_align_t) ? a : alignof(std::max_align_t);
+    }
+
+  private: // typedefs
+    /// @private
+    struct bin
+    {
+      std::size_t count = 0;
+      std::array<pointer, cache_size> ptrs;
+    };
+    /// @private
+    /// Per thread storage. Destroyed when its thread exits.
+    struct local
+    {
+      /// `thread_cache` that the blocks in `bins` belong to. Read without a lock by its thread so
+      /// that other threads can unbind it.
+      std::atomic<thread_cache *> owner = nullptr;
+      /// Neighbours in the list of caches bound to `owner`.
+      local * prev = nullptr;
+      local * next = nullptr;
+      std::array<bin, num_classes> bins;
+      ~local()
+      {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        if (auto o = owner.load(std::memory_order_relaxed))
+        {
+          o->unbind(*this);
+        }
+      }
+    };
+
+  public: // constructors
+    /// Defined because other constructors are defined.
+    thread_cache() = default;
+    /// Deleted because caches in other threads point to us.
+    thread_cache(thread_cache const &) = delete;
+    /// Deleted because caches in other threads point to us.
+    thread_cache & operator=(thread_cache const &) = delete;
+    /// Drains every cache that is bound to us back to `Upstream`.
+    ///
+    /// @pre No other thread is using or will use us.
+    ~thread_cache() noexcept
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex());
+      while (locals)
+      {
+        unbind(*locals);
+      }
+    }
+
+  public: // capacity
+    /// @returns The maximum allocation size supported. This is `Upstream::max_size()`.
+    static constexpr size_type max_size() noexcept
+    {
+      return resource_traits<Upstream>::max_size();
+    }
+
+  public: // modifiers
+    /// If `size` and `alignment` fit into a size class then pop a block from the calling thread's
+    /// cache, refilling it from `Upstream` if it is empty. Otherwise allocate from `Upstream`.
+    /// * Complexity `O(1)` when the cache isn't empty.
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment in bytes of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`
+    ///
+    /// @pre `size <= max_size()`
+    pointer allocate(size_type size, size_type alignment) noexcept
+    {
+      assert(size <= max_size());
+      if (auto const c = class_of(size, alignment); c != num_classes)
+      {
+        auto & b = bins_for_this_thread()[c];
+        if (b.count == 0)
+        {
+          refill(b, c);
+        }
+        if (b.count != 0)
+        {
+          return b.ptrs[--b.count];
+        }
+        return nullptr;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      return upstream.allocate(size, alignment);
+    }
+    /// If `size` and `alignment` fit into a size class then push `ptr` onto the calling thread's
+    /// cache, draining a batch to `Upstream` if it is full. Otherwise deallocate to `Upstream`.
+    /// * Complexity `O(1)` when the cache isn't full.
+    ///
+    /// @param ptr Pointer returned by a call to `allocate` from any thread.
+    /// @param size Corresponding parameter in the call to `allocate`.
+    /// @param alignment Corresponding parameter in the call to `allocate`.
+    void deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+    {
+      if (auto const c = class_of(size, alignment); c != num_classes)
+      {
+        auto & b = bins_for_this_thread()[c];
+        if (b.count == cache_size)
+        {
+          drain(b, c, batch_size);
+        }
+        b.ptrs[b.count++] = ptr;
+        return;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      upstream.deallocate(ptr, size, alignment);
+    }
+
+  public: // accessors
+    /// @returns Reference to `Upstream`. Access to it is not synchronized.
+    Upstream & get_upstream() noexcept
+    {
+      return upstream;
+    }
+    /// @returns Reference to `Upstream`. Access to it is not synchronized.
+    Upstream const & get_upstream() const noexcept
+    {
+      return upstream;
+    }
+
+  private: // helpers
+    /// @returns (success) Index of the smallest size class that fits `size` and `alignment`.
+    /// @returns (failure) `num_classes`
+    static std::size_t class_of(size_type size, size_type alignment) noexcept
+    {
+      for (std::size_t c = 0; c != num_classes; ++c)
+      {
+        if (size <= class_sizes[c])
+        {
+          return alignment <= class_alignment(c) ? c : num_classes;
+        }
+      }
+      return num_classes;
+    }
+    /// @returns Calling thread's bins, bound to us.
+    std::array<bin, num_classes> & bins_for_this_thread() noexcept
+    {
+      static thread_local local l;
+      if (l.owner.load(std::memory_order_relaxed) != this)
+      {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        if (auto o = l.owner.load(std::memory_order_relaxed))
+        {
+          o->unbind(l);
+        }
+        bind(l);
+      }
+      return l.bins;
+    }
+    /// Allocate up to `batch_size` blocks from `Upstream` into `b`.
+    ///
+    /// @pre `b.count == 0`
+    void refill(bin & b, std::size_t c) noexcept
+    {
+      assert(b.count == 0);
+      std::lock_guard<std::mutex> lock(mutex);
+      for (; b.count != batch_size; ++b.count)
+      {
+        auto ptr = upstream.allocate(static_cast<size_type>(class_sizes[c]),
+          static_cast<size_type>(class_alignment(c)));
+        if (!ptr)
+        {
+          break;
+        }
+        b.ptrs[b.count] = ptr;
+      }
+    }
+    /// Deallocate `n` blocks from `b` back to `Upstream`.
+    ///
+    /// @pre `n <= b.count`
+    void drain(bin & b, std::size_t c, std::size_t n) noexcept
+    {
+      assert(n <= b.count);
+      std::lock_guard<std::mutex> lock(mutex);
+      for (; n; --n)
+      {
+        upstream.deallocate(b.ptrs[--b.count],
+          static_cast<size_type>(class_sizes[c]),
+          static_cast<size_type>(class_alignment(c)));
+      }
+    }
+
+  private: // registry
+    /// Guards the lists of caches bound to every `thread_cache` of this type.
+    static std::mutex & registry_mutex() noexcept
+    {
+      static std::mutex m;
+      return m;
+    }
+    /// Put `l` at the front of our list of caches.
+    ///
+    /// @pre `registry_mutex()` is locked.
+    /// @pre `l` isn't bound.
+    void bind(local & l) noexcept
+    {
+      l.prev = nullptr;
+      l.next = locals;
+      if (locals)
+      {
+        locals->prev = &l;
+      }
+      locals = &l;
+      l.owner.store(this, std::memory_order_relaxed);
+    }
+    /// Drain `l` back to `Upstream` and take it off of our list of caches.
+    ///
+    /// @pre `registry_mutex()` is locked.
+    /// @pre `l` is bound to us.
+    void unbind(local & l) noexcept
+    {
+      for (std::size_t c = 0; c != num_classes; ++c)
+      {
+        drain(l.bins[c], c, l.bins[c].count);
+      }
+      (l.prev ? l.prev->next : locals) = l.next;
+      if (l.next)
+      {
+        l.next->prev = l.prev;
+      }
+      l.owner.store(nullptr, std::memory_order_relaxed);
+    }
+
+  private: // variables
+    /// Caches bound to us.
+    local * locals = nullptr;
+    /// Guards `Upstream`.
+    std::mutex mutex;
+    Upstream upstream;
+  };
+}
\ No newline at end of file
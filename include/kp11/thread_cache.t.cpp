@@ -0,0 +1,137 @@
+#include "thread_cache.h"
+
+#include "heap.h" // heap
+#include "traits.h" // is_resource_v
+
+#include <catch.hpp>
+
+#include <thread> // thread
+
+using namespace kp11;
+
+/// @private
+/// Counts the number of blocks allocated from it that haven't been deallocated.
+class counting
+{
+public:
+  using pointer = typename heap::pointer;
+  using size_type = typename heap::size_type;
+  static inline int outstanding = 0;
+  pointer allocate(size_type size, size_type alignment) noexcept
+  {
+    ++outstanding;
+    return m.allocate(size, alignment);
+  }
+  void deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+  {
+    --outstanding;
+    m.deallocate(ptr, size, alignment);
+  }
+
+private:
+  heap m;
+};
+
+using resource = thread_cache<counting, 16, 32, 64>;
+
+TEST_CASE("max_size", "[max_size]")
+{
+  REQUIRE(resource::max_size() == resource_traits<counting>::max_size());
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  counting::outstanding = 0;
+  {
+    resource m;
+    SECTION("refills a batch")
+    {
+      auto a = m.allocate(16, 8);
+      REQUIRE(a != nullptr);
+      REQUIRE(counting::outstanding == resource::batch_size);
+      auto b = m.allocate(12, 4);
+      REQUIRE(b != nullptr);
+      REQUIRE(b != a);
+      REQUIRE(counting::outstanding == resource::batch_size);
+      m.deallocate(a, 16, 8);
+      m.deallocate(b, 12, 4);
+    }
+    SECTION("reuses the most recently deallocated block")
+    {
+      auto a = m.allocate(32, 16);
+      m.deallocate(a, 32, 16);
+      REQUIRE(m.allocate(32, 16) == a);
+      m.deallocate(a, 32, 16);
+    }
+    SECTION("drains a batch")
+    {
+      void * ptrs[resource::cache_size + 1];
+      for (auto & p : ptrs)
+      {
+        p = m.allocate(64, 16);
+      }
+      for (auto p : ptrs)
+      {
+        m.deallocate(p, 64, 16);
+      }
+      REQUIRE(counting::outstanding <= static_cast<int>(resource::cache_size));
+    }
+    SECTION("too large goes to upstream")
+    {
+      auto a = m.allocate(65, 8);
+      REQUIRE(counting::outstanding == 1);
+      m.deallocate(a, 65, 8);
+      REQUIRE(counting::outstanding == 0);
+    }
+    SECTION("over aligned goes to upstream")
+    {
+      auto a = m.allocate(16, 32);
+      REQUIRE(counting::outstanding == 1);
+      m.deallocate(a, 16, 32);
+      REQUIRE(counting::outstanding == 0);
+    }
+  }
+  // the destructor drains the cache of this thread
+  REQUIRE(counting::outstanding == 0);
+}
+TEST_CASE("threads", "[threads]")
+{
+  counting::outstanding = 0;
+  resource m;
+  SECTION("thread exit drains its cache")
+  {
+    std::thread t([&m] {
+      auto a = m.allocate(16, 8);
+      m.deallocate(a, 16, 8);
+    });
+    t.join();
+    REQUIRE(counting::outstanding == 0);
+  }
+  SECTION("deallocate from another thread")
+  {
+    auto a = m.allocate(16, 8);
+    std::thread t([&m, a] { m.deallocate(a, 16, 8); });
+    t.join();
+    REQUIRE(counting::outstanding == resource::batch_size - 1);
+    auto b = m.allocate(16, 8);
+    m.deallocate(b, 16, 8);
+  }
+}
+TEST_CASE("rebind", "[rebind]")
+{
+  counting::outstanding = 0;
+  resource m;
+  resource n;
+  auto a = m.allocate(16, 8);
+  REQUIRE(counting::outstanding == resource::batch_size);
+  auto b = n.allocate(16, 8);
+  // m's cache has been drained, apart from `a`
+  REQUIRE(counting::outstanding == resource::batch_size + 1);
+  m.deallocate(a, 16, 8);
+  // n's cache has been drained, `a` is cached by m and `b` is still allocated
+  REQUIRE(counting::outstanding == 2);
+  n.deallocate(b, 16, 8);
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_resource_v<resource> == true);
+}
\ No newline at end of file
@@ -58,6 +58,19 @@ namespace kp11
   template<template<typename...> typename T, typename... Args>
   inline constexpr auto is_detected_v = is_detected<T, Args...>::value;
 
+  /// @brief Memory returned by `allocate_at_least`, in the shape of `std::allocation_result`.
+  ///
+  /// For a `Resource`, `count` is the usable size in bytes, which is at least the size requested.
+  /// Any size in [size requested, `count`] can be passed to `deallocate`.
+  template<typename Pointer, typename SizeType = std::size_t>
+  struct allocation_result
+  {
+    /// Pointer to the beginning of the memory or `nullptr` on failure.
+    Pointer ptr;
+    /// Usable size of the memory or `0` on failure.
+    SizeType count;
+  };
+
   /// @brief Provides a standardized way of accessing optional properties of `Resources`.
   template<typename T>
   struct resource_traits
@@ -98,6 +111,169 @@ namespace kp11
         return std::numeric_limits<size_type>::max();
       }
     }
+
+  public: // allocate_at_least
+    /// Result type of `allocate_at_least`.
+    using allocation_result_type = allocation_result<pointer, size_type>;
+    /// @private
+    template<typename R>
+    static auto AllocateAtLeastProvided_h(R & r, size_type size = {}, size_type alignment = {})
+      -> decltype(NoexceptSame(r.allocate_at_least(size, alignment), allocation_result_type));
+    /// Check if `R` provides the proper allocate_at_least function.
+    template<typename R>
+    using AllocateAtLeastProvided = decltype(AllocateAtLeastProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper allocate_at_least function.
+    using allocate_at_least_provided = is_detected<AllocateAtLeastProvided, T>;
+    /// Check if `T` provides the proper allocate_at_least function.
+    static constexpr auto allocate_at_least_provided_v = allocate_at_least_provided::value;
+    /// `r.allocate_at_least(size, alignment)` if provided otherwise `r.allocate(size, alignment)`
+    /// with a usable size of exactly `size`.
+    ///
+    /// @returns (success) Pointer and usable size in bytes, which is at least `size`.
+    /// @returns (failure) `nullptr` and `0`.
+    static allocation_result_type allocate_at_least(
+      T & r, size_type size, size_type alignment) noexcept
+    {
+      if constexpr (allocate_at_least_provided_v)
+      {
+        return r.allocate_at_least(size, alignment);
+      }
+      else
+      {
+        auto ptr = r.allocate(size, alignment);
+        return {ptr, ptr ? size : 0};
+      }
+    }
+
+  public: // expand
+    /// @private
+    template<typename R>
+    static auto ExpandProvided_h(R & r, pointer ptr = {}, size_type size = {})
+      -> decltype(NoexceptConv(r.expand(ptr, size, size), bool));
+    /// Check if `R` provides the proper expand function.
+    template<typename R>
+    using ExpandProvided = decltype(ExpandProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper expand function.
+    using expand_provided = is_detected<ExpandProvided, T>;
+    /// Check if `T` provides the proper expand function.
+    static constexpr auto expand_provided_v = expand_provided::value;
+    /// `r.expand(ptr, old_size, new_size)` if provided otherwise `false`.
+    ///
+    /// @returns `true` if the memory at `ptr` was grown in place to `new_size` bytes, after which
+    /// it must be deallocated with `new_size`. `false` if nothing was changed.
+    ///
+    /// @pre `old_size <= new_size`
+    /// @pre `new_size <= max_size()`
+    static bool expand(T & r, pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      assert(old_size <= new_size);
+      if constexpr (expand_provided_v)
+      {
+        return r.expand(ptr, old_size, new_size);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+  public: // shrink
+    /// @private
+    template<typename R>
+    static auto ShrinkProvided_h(R & r, pointer ptr = {}, size_type size = {})
+      -> decltype(NoexceptConv(r.shrink(ptr, size, size), bool));
+    /// Check if `R` provides the proper shrink function.
+    template<typename R>
+    using ShrinkProvided = decltype(ShrinkProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper shrink function.
+    using shrink_provided = is_detected<ShrinkProvided, T>;
+    /// Check if `T` provides the proper shrink function.
+    static constexpr auto shrink_provided_v = shrink_provided::value;
+    /// `r.shrink(ptr, old_size, new_size)` if provided otherwise `false`.
+    ///
+    /// @returns `true` if the memory at `ptr` was shrunk in place to `new_size` bytes, after which
+    /// it must be deallocated with `new_size`. `false` if nothing was changed.
+    ///
+    /// @pre `new_size <= old_size`
+    static bool shrink(T & r, pointer ptr, size_type old_size, size_type new_size) noexcept
+    {
+      assert(new_size <= old_size);
+      if constexpr (shrink_provided_v)
+      {
+        return r.shrink(ptr, old_size, new_size);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+  public: // allocate_bulk
+    /// @private
+    template<typename R>
+    static auto AllocateBulkProvided_h(R & r, size_type n = {}, pointer * out = {})
+      -> decltype(NoexceptSame(r.allocate_bulk(n, n, n, out), size_type));
+    /// Check if `R` provides the proper allocate_bulk function.
+    template<typename R>
+    using AllocateBulkProvided = decltype(AllocateBulkProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper allocate_bulk function.
+    using allocate_bulk_provided = is_detected<AllocateBulkProvided, T>;
+    /// Check if `T` provides the proper allocate_bulk function.
+    static constexpr auto allocate_bulk_provided_v = allocate_bulk_provided::value;
+    /// `r.allocate_bulk(size, alignment, n, out)` if provided otherwise calls
+    /// `r.allocate(size, alignment)` until `n` have been allocated or one fails.
+    ///
+    /// @returns Number of allocations written to the front of `out`.
+    static size_type allocate_bulk(
+      T & r, size_type size, size_type alignment, size_type n, pointer * out) noexcept
+    {
+      if constexpr (allocate_bulk_provided_v)
+      {
+        return r.allocate_bulk(size, alignment, n, out);
+      }
+      else
+      {
+        size_type i = 0;
+        for (; i != n; ++i)
+        {
+          if (!(out[i] = r.allocate(size, alignment)))
+          {
+            break;
+          }
+        }
+        return i;
+      }
+    }
+
+  public: // deallocate_bulk
+    /// @private
+    template<typename R>
+    static auto DeallocateBulkProvided_h(R & r, pointer const * ptrs = {}, size_type n = {})
+      -> decltype(Noexcept(r.deallocate_bulk(ptrs, n, n, n)));
+    /// Check if `R` provides the proper deallocate_bulk function.
+    template<typename R>
+    using DeallocateBulkProvided = decltype(DeallocateBulkProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper deallocate_bulk function.
+    using deallocate_bulk_provided = is_detected<DeallocateBulkProvided, T>;
+    /// Check if `T` provides the proper deallocate_bulk function.
+    static constexpr auto deallocate_bulk_provided_v = deallocate_bulk_provided::value;
+    /// `r.deallocate_bulk(ptrs, size, alignment, n)` if provided otherwise calls
+    /// `r.deallocate(ptrs[i], size, alignment)` for each of the `n` pointers.
+    static void deallocate_bulk(
+      T & r, pointer const * ptrs, size_type size, size_type alignment, size_type n) noexcept
+    {
+      if constexpr (deallocate_bulk_provided_v)
+      {
+        r.deallocate_bulk(ptrs, size, alignment, n);
+      }
+      else
+      {
+        for (size_type i = 0; i != n; ++i)
+        {
+          r.deallocate(ptrs[i], size, alignment);
+        }
+      }
+    }
   };
   /// @private
   template<typename R,
@@ -209,6 +385,131 @@ namespace kp11
         return T::size();
       }
     }
+
+  public: // largest_free_run
+    /// @private
+    template<typename R>
+    static auto LargestFreeRunProvided_h(R & r)
+      -> decltype(NoexceptSame(r.largest_free_run(), size_type));
+    /// Check if `R` provides the proper largest_free_run function.
+    template<typename R>
+    using LargestFreeRunProvided = decltype(LargestFreeRunProvided_h(std::declval<R const &>()));
+    /// Check if `T` provides the proper largest_free_run function.
+    using largest_free_run_provided = is_detected<LargestFreeRunProvided, T>;
+    /// Check if `T` provides the proper largest_free_run function.
+    static constexpr auto largest_free_run_provided_v = largest_free_run_provided::value;
+    /// `marker.largest_free_run()` if present otherwise `1` if `marker` has unallocated indexes,
+    /// which is a lower bound.
+    static size_type largest_free_run(T const & marker) noexcept
+    {
+      if constexpr (largest_free_run_provided_v)
+      {
+        return marker.largest_free_run();
+      }
+      else
+      {
+        return static_cast<size_type>(marker.count() != T::size());
+      }
+    }
+
+  public: // expand
+    /// @private
+    template<typename R>
+    static auto ExpandProvided_h(R & r, size_type n = {})
+      -> decltype(NoexceptConv(r.expand(n, n, n), bool));
+    /// Check if `R` provides the proper expand function.
+    template<typename R>
+    using ExpandProvided = decltype(ExpandProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper expand function.
+    using expand_provided = is_detected<ExpandProvided, T>;
+    /// Check if `T` provides the proper expand function.
+    static constexpr auto expand_provided_v = expand_provided::value;
+    /// `marker.expand(i, old_n, new_n)` if present otherwise `false`.
+    ///
+    /// @returns `true` if the run at `i` was grown in place to `new_n` indexes, after which it
+    /// must be deallocated with `new_n`. `false` if nothing was changed.
+    ///
+    /// @pre `0 < old_n <= new_n`
+    static bool expand(T & marker, size_type i, size_type old_n, size_type new_n) noexcept
+    {
+      assert(0 < old_n && old_n <= new_n);
+      if constexpr (expand_provided_v)
+      {
+        return marker.expand(i, old_n, new_n);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+  public: // shrink
+    /// @private
+    template<typename R>
+    static auto ShrinkProvided_h(R & r, size_type n = {})
+      -> decltype(NoexceptConv(r.shrink(n, n, n), bool));
+    /// Check if `R` provides the proper shrink function.
+    template<typename R>
+    using ShrinkProvided = decltype(ShrinkProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper shrink function.
+    using shrink_provided = is_detected<ShrinkProvided, T>;
+    /// Check if `T` provides the proper shrink function.
+    static constexpr auto shrink_provided_v = shrink_provided::value;
+    /// `marker.shrink(i, old_n, new_n)` if present otherwise `false`.
+    ///
+    /// @returns `true` if the run at `i` was shrunk in place to `new_n` indexes, after which it
+    /// must be deallocated with `new_n`. `false` if nothing was changed.
+    ///
+    /// @pre `0 < new_n <= old_n`
+    static bool shrink(T & marker, size_type i, size_type old_n, size_type new_n) noexcept
+    {
+      assert(0 < new_n && new_n <= old_n);
+      if constexpr (shrink_provided_v)
+      {
+        return marker.shrink(i, old_n, new_n);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+  public: // allocate_bulk
+    /// @private
+    template<typename R>
+    static auto AllocateBulkProvided_h(R & r, size_type n = {}, size_type * out = {})
+      -> decltype(NoexceptSame(r.allocate_bulk(n, n, out), size_type));
+    /// Check if `R` provides the proper allocate_bulk function.
+    template<typename R>
+    using AllocateBulkProvided = decltype(AllocateBulkProvided_h(std::declval<R &>()));
+    /// Check if `T` provides the proper allocate_bulk function.
+    using allocate_bulk_provided = is_detected<AllocateBulkProvided, T>;
+    /// Check if `T` provides the proper allocate_bulk function.
+    static constexpr auto allocate_bulk_provided_v = allocate_bulk_provided::value;
+    /// `marker.allocate_bulk(n, count, out)` if present otherwise calls `marker.allocate(n)` until
+    /// `count` have been allocated or one fails.
+    ///
+    /// @returns Number of indexes of runs of `n` written to the front of `out`.
+    static size_type allocate_bulk(
+      T & marker, size_type n, size_type count, size_type * out) noexcept
+    {
+      if constexpr (allocate_bulk_provided_v)
+      {
+        return marker.allocate_bulk(n, count, out);
+      }
+      else
+      {
+        size_type i = 0;
+        for (; i != count; ++i)
+        {
+          if ((out[i] = marker.allocate(n)) == T::size())
+          {
+            break;
+          }
+        }
+        return i;
+      }
+    }
   };
   /// @private
   template<typename R, typename size_type = typename R::size_type>
@@ -57,6 +57,133 @@ TEST_CASE("resource_traits", "[resource_traits]")
     REQUIRE(rt::max_size() == test_resource::max_size());
   }
 }
+/// @private
+class counting_test_resource
+{
+public:
+  using pointer = void *;
+  using size_type = std::size_t;
+  pointer allocate(size_type size, size_type alignment) noexcept
+  {
+    return remaining ? (--remaining, &remaining) : nullptr;
+  }
+  void deallocate(pointer ptr, size_type size, size_type alignment) noexcept
+  {
+    ++remaining;
+  }
+  size_type remaining = 3;
+};
+/// @private
+class bulk_test_resource : public counting_test_resource
+{
+public:
+  size_type allocate_bulk(
+    size_type size, size_type alignment, size_type n, pointer * out) noexcept
+  {
+    return 7;
+  }
+  void deallocate_bulk(
+    pointer const * ptrs, size_type size, size_type alignment, size_type n) noexcept
+  {
+    remaining = 42;
+  }
+};
+TEST_CASE("resource_traits bulk", "[resource_traits]")
+{
+  void * ptrs[5] = {};
+  SECTION("fallback")
+  {
+    counting_test_resource x;
+    using rt = resource_traits<decltype(x)>;
+    REQUIRE(rt::allocate_bulk_provided_v == false);
+    REQUIRE(rt::deallocate_bulk_provided_v == false);
+    REQUIRE(rt::allocate_bulk(x, 1, 1, 2, ptrs) == 2);
+    REQUIRE(x.remaining == 1);
+    REQUIRE(rt::allocate_bulk(x, 1, 1, 5, ptrs + 2) == 1);
+    REQUIRE(ptrs[3] == nullptr);
+    rt::deallocate_bulk(x, ptrs, 1, 1, 3);
+    REQUIRE(x.remaining == 3);
+  }
+  SECTION("provided")
+  {
+    bulk_test_resource x;
+    using rt = resource_traits<decltype(x)>;
+    REQUIRE(rt::allocate_bulk_provided_v == true);
+    REQUIRE(rt::deallocate_bulk_provided_v == true);
+    REQUIRE(rt::allocate_bulk(x, 1, 1, 5, ptrs) == 7);
+    rt::deallocate_bulk(x, ptrs, 1, 1, 5);
+    REQUIRE(x.remaining == 42);
+  }
+}
+/// @private
+class at_least_test_resource : public counting_test_resource
+{
+public:
+  allocation_result<pointer, size_type> allocate_at_least(
+    size_type size, size_type alignment) noexcept
+  {
+    return {allocate(size, alignment), size * 2};
+  }
+};
+TEST_CASE("resource_traits allocate_at_least", "[resource_traits]")
+{
+  SECTION("fallback")
+  {
+    counting_test_resource x;
+    using rt = resource_traits<decltype(x)>;
+    REQUIRE(rt::allocate_at_least_provided_v == false);
+    auto a = rt::allocate_at_least(x, 5, 1);
+    REQUIRE(a.ptr != nullptr);
+    REQUIRE(a.count == 5);
+    x.remaining = 0;
+    auto b = rt::allocate_at_least(x, 5, 1);
+    REQUIRE(b.ptr == nullptr);
+    REQUIRE(b.count == 0);
+  }
+  SECTION("provided")
+  {
+    at_least_test_resource x;
+    using rt = resource_traits<decltype(x)>;
+    REQUIRE(rt::allocate_at_least_provided_v == true);
+    REQUIRE(rt::allocate_at_least(x, 5, 1).count == 10);
+  }
+}
+/// @private
+class resize_test_resource : public counting_test_resource
+{
+public:
+  bool expand(pointer ptr, size_type old_size, size_type new_size) noexcept
+  {
+    return new_size < 8;
+  }
+  bool shrink(pointer ptr, size_type old_size, size_type new_size) noexcept
+  {
+    return new_size > 2;
+  }
+};
+TEST_CASE("resource_traits expand/shrink", "[resource_traits]")
+{
+  SECTION("fallback")
+  {
+    counting_test_resource x;
+    using rt = resource_traits<decltype(x)>;
+    REQUIRE(rt::expand_provided_v == false);
+    REQUIRE(rt::shrink_provided_v == false);
+    REQUIRE(rt::expand(x, &x, 4, 6) == false);
+    REQUIRE(rt::shrink(x, &x, 4, 3) == false);
+  }
+  SECTION("provided")
+  {
+    resize_test_resource x;
+    using rt = resource_traits<decltype(x)>;
+    REQUIRE(rt::expand_provided_v == true);
+    REQUIRE(rt::shrink_provided_v == true);
+    REQUIRE(rt::expand(x, &x, 4, 6) == true);
+    REQUIRE(rt::expand(x, &x, 4, 8) == false);
+    REQUIRE(rt::shrink(x, &x, 4, 3) == true);
+    REQUIRE(rt::shrink(x, &x, 4, 2) == false);
+  }
+}
 TEST_CASE("is_resource", "[resource_traits]")
 {
   REQUIRE(is_resource_v<int> == false);
@@ -128,6 +255,22 @@ public:
   {
     return 5;
   }
+  size_type largest_free_run() const noexcept
+  {
+    return 7;
+  }
+  size_type allocate_bulk(size_type n, size_type count, size_type * out) noexcept
+  {
+    return 2;
+  }
+  bool expand(size_type i, size_type old_n, size_type new_n) noexcept
+  {
+    return true;
+  }
+  bool shrink(size_type i, size_type old_n, size_type new_n) noexcept
+  {
+    return true;
+  }
   size_type allocate(size_type n) noexcept
   {
     return 0;
@@ -166,12 +309,28 @@ TEST_CASE("marker_traits", "[marker_traits]")
     minimal_test_marker m;
     using mt = marker_traits<decltype(m)>;
     REQUIRE(mt::max_size() == decltype(m)::size());
+    REQUIRE(mt::largest_free_run(m) == 1);
+    std::size_t out[3] = {};
+    REQUIRE(mt::allocate_bulk_provided_v == false);
+    REQUIRE(mt::allocate_bulk(m, 1, 3, out) == 3);
+    REQUIRE(mt::expand_provided_v == false);
+    REQUIRE(mt::expand(m, 0, 1, 2) == false);
+    REQUIRE(mt::shrink_provided_v == false);
+    REQUIRE(mt::shrink(m, 0, 2, 1) == false);
   }
   SECTION("full")
   {
     test_marker m;
     using mt = marker_traits<decltype(m)>;
     REQUIRE(mt::max_size() == decltype(m)::max_size());
+    REQUIRE(mt::largest_free_run(m) == 7);
+    std::size_t out[3] = {};
+    REQUIRE(mt::allocate_bulk_provided_v == true);
+    REQUIRE(mt::allocate_bulk(m, 1, 3, out) == 2);
+    REQUIRE(mt::expand_provided_v == true);
+    REQUIRE(mt::expand(m, 0, 1, 2) == true);
+    REQUIRE(mt::shrink_provided_v == true);
+    REQUIRE(mt::shrink(m, 0, 2, 1) == true);
   }
 }
 TEST_CASE("is_marker", "[marker_traits]")
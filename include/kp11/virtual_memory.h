@@ -0,0 +1,174 @@
+#pragma once
+
+#include "bitset.h" // bitset
+#include "traits.h" // is_marker_v, marker_traits
+
+#include <cassert> // assert
+#include <cstddef> // size_t, byte
+#include <utility> // exchange
+
+#include <sys/mman.h> // mmap, munmap, mprotect, madvise, PROT_NONE, PROT_READ, PROT_WRITE, MAP_PRIVATE, MAP_ANONYMOUS, MAP_NORESERVE, MAP_FAILED, MADV_DONTNEED
+
+namespace kp11
+{
+  /// @brief Reserve a range of address space up front and commit pages of it on demand.
+  ///
+  /// `ReserveSize` bytes of address space are reserved on construction without any access, so no
+  /// memory is used until it is allocated. Allocations are whole pages found by `Marker`, which
+  /// are committed with read and write access on `allocate`. On `deallocate` they are handed back
+  /// to the operating system and made inaccessible again. Used as the `Upstream` of `monotonic` or
+  /// `free_block`, consecutive chunks are contiguous and idle chunks stop using memory once they
+  /// are deallocated e.g. by `release` or `shrink_to_fit`.
+  ///
+  /// @tparam ReserveSize Size in bytes of the address space reserved.
+  /// @tparam PageSize Size in bytes of a page. Must be a multiple of the operating system page size.
+  /// @tparam Marker Meets the `Marker` concept. Has an index for each page.
+  template<std::size_t ReserveSize,
+    std::size_t PageSize = 4096,
+    typename Marker = bitset<ReserveSize / PageSize>>
+  class virtual_memory
+  {
+    static_assert(is_marker_v<Marker>);
+    static_assert(ReserveSize % PageSize == 0);
+    static_assert(static_cast<std::size_t>(Marker::size()) == ReserveSize / PageSize);
+
+  public: // typedefs
+    /// Pointer type.
+    using pointer = void *;
+    /// Size type.
+    using size_type = std::size_t;
+
+  private: // typedefs
+    using index_type = typename Marker::size_type;
+
+  public: // constants
+    /// Size in bytes of the address space reserved.
+    static constexpr auto reserve_size = ReserveSize;
+    /// Size in bytes of a page.
+    static constexpr auto page_size = PageSize;
+
+  public: // constructors
+    /// Reserve the address space. If this fails then every allocation fails.
+    virtual_memory() noexcept
+    {
+      auto ptr = ::mmap(
+        nullptr, reserve_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      base = ptr == MAP_FAILED ? nullptr : static_cast<std::byte *>(ptr);
+    }
+    /// Deleted because the address space is being held and managed.
+    virtual_memory(virtual_memory const &) = delete;
+    /// Defined because the destructor is defined. `x` is left without any address space.
+    virtual_memory(virtual_memory && x) noexcept :
+        base(std::exchange(x.base, nullptr)), marker(std::exchange(x.marker, Marker()))
+    {
+    }
+    /// Deleted because the address space is being held and managed.
+    virtual_memory & operator=(virtual_memory const &) = delete;
+    /// Defined because the destructor is defined. `x` is left without any address space.
+    virtual_memory & operator=(virtual_memory && x) noexcept
+    {
+      if (this != &x)
+      {
+        unmap();
+        base = std::exchange(x.base, nullptr);
+        marker = std::exchange(x.marker, Marker());
+      }
+      return *this;
+    }
+    /// Defined because the address space needs to be given back to the operating system.
+    ~virtual_memory() noexcept
+    {
+      unmap();
+    }
+
+  public: // capacity
+    /// @returns The maximum allocation size supported.
+    static constexpr size_type max_size() noexcept
+    {
+      return static_cast<size_type>(marker_traits<Marker>::max_size()) * page_size;
+    }
+    /// @returns Number of bytes committed.
+    size_type committed() const noexcept
+    {
+      return static_cast<size_type>(marker.count()) * page_size;
+    }
+
+  public: // modifiers
+    /// Allocate enough pages for `size` from `Marker` and commit them.
+    /// * Complexity `O(Marker) + mprotect`
+    ///
+    /// @param size Size in bytes of memory to allocate.
+    /// @param alignment Alignment in bytes of memory to allocate.
+    ///
+    /// @returns (success) Pointer to the beginning of a suitable memory block.
+    /// @returns (failure) `nullptr`
+    ///
+    /// @pre `page_size % alignment == 0`
+    /// @pre `size <= max_size()`
+    pointer allocate(size_type size, [[maybe_unused]] size_type alignment) noexcept
+    {
+      assert(page_size % alignment == 0);
+      assert(size <= max_size());
+      if (!base)
+      {
+        return nullptr;
+      }
+      auto const n = to_pages(size);
+      auto const i = marker.allocate(n);
+      if (i == Marker::size())
+      {
+        return nullptr;
+      }
+      auto ptr = base + static_cast<size_type>(i) * page_size;
+      if (::mprotect(ptr, static_cast<size_type>(n) * page_size, PROT_READ | PROT_WRITE) != 0)
+      {
+        marker.deallocate(i, n);
+        return nullptr;
+      }
+      return ptr;
+    }
+    /// Give the pages back to the operating system, make them inaccessible and deallocate them from
+    /// `Marker`. The next time that they are allocated they are zero filled.
+    /// * Complexity `O(Marker) + madvise + mprotect`
+    ///
+    /// @param ptr Pointer returned by a call to `allocate`.
+    /// @param size Corresponding parameter used in `allocate`.
+    /// @param alignment Corresponding parameter used in `allocate`.
+    void deallocate(pointer ptr, size_type size, size_type) noexcept
+    {
+      auto p = static_cast<std::byte *>(ptr);
+      assert(base <= p && p < base + reserve_size);
+      auto const n = to_pages(size);
+      auto const bytes = static_cast<size_type>(n) * page_size;
+      ::madvise(p, bytes, MADV_DONTNEED);
+      ::mprotect(p, bytes, PROT_NONE);
+      marker.deallocate(static_cast<index_type>(static_cast<size_type>(p - base) / page_size), n);
+    }
+
+  public: // observers
+    /// @returns Beginning of the reserved address space or `nullptr` if it couldn't be reserved.
+    pointer data() const noexcept
+    {
+      return base;
+    }
+
+  private: // helpers
+    static index_type to_pages(size_type size) noexcept
+    {
+      return static_cast<index_type>((size == 0) + size / page_size + (size % page_size != 0));
+    }
+    void unmap() noexcept
+    {
+      if (base)
+      {
+        ::munmap(base, reserve_size);
+      }
+    }
+
+  private: // variables
+    /// Beginning of the reserved address space.
+    std::byte * base = nullptr;
+    /// An index for each page of the reserved address space.
+    Marker marker;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "virtual_memory.h"
+
+#include "free_block.h" // free_block, dynamic_chunks
+#include "monotonic.h" // monotonic
+#include "pool.h" // pool
+#include "traits.h" // is_resource_v
+
+#include <catch.hpp>
+
+#include <cstddef> // byte
+#include <cstring> // memset
+
+using namespace kp11;
+
+TEST_CASE("max_size", "[max_size]")
+{
+  REQUIRE(virtual_memory<1 << 20>::max_size() == 1 << 20);
+  REQUIRE(virtual_memory<1 << 20, 8192>::max_size() == 1 << 20);
+  REQUIRE(virtual_memory<1 << 20, 4096, pool<256>>::max_size() == 4096);
+}
+TEST_CASE("constructor", "[constructor]")
+{
+  virtual_memory<1 << 20> m;
+  REQUIRE(m.data() != nullptr);
+  auto a = m.allocate(4096, 4096);
+  SECTION("move")
+  {
+    auto n = std::move(m);
+    REQUIRE(m.data() == nullptr);
+    REQUIRE(m.allocate(4096, 4096) == nullptr);
+    REQUIRE(n.committed() == 4096);
+    n.deallocate(a, 4096, 4096);
+  }
+  SECTION("move assignment")
+  {
+    decltype(m) n;
+    n = std::move(m);
+    REQUIRE(m.data() == nullptr);
+    REQUIRE(n.committed() == 4096);
+    n.deallocate(a, 4096, 4096);
+  }
+}
+TEST_CASE("allocate", "[allocate]")
+{
+  virtual_memory<1 << 20> m;
+  auto a = static_cast<std::byte *>(m.allocate(100, 16));
+  REQUIRE(a == m.data());
+  REQUIRE(m.committed() == 4096);
+  std::memset(a, 1, 4096);
+  SECTION("pages are contiguous")
+  {
+    auto b = static_cast<std::byte *>(m.allocate(10000, 16));
+    REQUIRE(b == a + 4096);
+    REQUIRE(m.committed() == 4 * 4096);
+    std::memset(b, 1, 3 * 4096);
+  }
+  SECTION("failure")
+  {
+    REQUIRE(m.allocate(1 << 20, 16) == nullptr);
+    REQUIRE(m.committed() == 4096);
+  }
+}
+TEST_CASE("deallocate", "[deallocate]")
+{
+  virtual_memory<1 << 20> m;
+  auto a = static_cast<std::byte *>(m.allocate(8192, 16));
+  std::memset(a, 1, 8192);
+  m.deallocate(a, 8192, 16);
+  REQUIRE(m.committed() == 0);
+  SECTION("recommitted pages are zero filled")
+  {
+    auto b = static_cast<std::byte *>(m.allocate(8192, 16));
+    REQUIRE(b == a);
+    REQUIRE(b[0] == std::byte(0));
+    REQUIRE(b[8191] == std::byte(0));
+  }
+}
+TEST_CASE("upstream", "[upstream]")
+{
+  SECTION("monotonic")
+  {
+    monotonic<8192, 4096, 4, virtual_memory<1 << 20>> m;
+    auto a = static_cast<std::byte *>(m.allocate(8192, 16));
+    auto b = static_cast<std::byte *>(m.allocate(8192, 16));
+    REQUIRE(b == a + 8192);
+    REQUIRE(m.get_upstream().committed() == 2 * 8192);
+    m.release();
+    REQUIRE(m.get_upstream().committed() == 0);
+  }
+  SECTION("free_block")
+  {
+    free_block<8192, 4096, 4, pool<2>, virtual_memory<1 << 20>> m;
+    m.allocate(4096, 16);
+    m.allocate(4096, 16);
+    auto c = m.allocate(4096, 16);
+    REQUIRE(m.get_upstream().committed() == 2 * 8192);
+    m.deallocate(c, 4096, 16);
+    m.shrink_to_fit();
+    REQUIRE(m.get_upstream().committed() == 8192);
+  }
+  SECTION("dynamic_chunks")
+  {
+    // The index of chunks isn't allocated from upstream, so chunks stay contiguous.
+    free_block<8192, 4096, dynamic_chunks, pool<2>, virtual_memory<1 << 20>> m;
+    auto a = static_cast<std::byte *>(m.allocate(4096, 16));
+    for (int i = 1; i < 12; ++i)
+    {
+      REQUIRE(m.allocate(4096, 16) != nullptr);
+    }
+    REQUIRE(m.get_upstream().committed() == 6 * 8192);
+    for (int k = 0; k < 6; ++k)
+    {
+      REQUIRE(m[a + k * 8192] == a + k * 8192);
+    }
+  }
+}
+TEST_CASE("traits", "[traits]")
+{
+  REQUIRE(is_resource_v<virtual_memory<1 << 20>> == true);
+}
\ No newline at end of file
@@ -4,12 +4,36 @@
 
 namespace kp11
 {
+  namespace
+  {
+    /// @returns `size` rounded up to a multiple of `alignment` or of the default alignment of
+    /// `new`, whichever is larger. `size` if that would overflow, which `new` will fail anyway.
+    std::size_t round_up(std::size_t size, std::size_t alignment) noexcept
+    {
+      auto const granule = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                             ? alignment
+                             : std::size_t(__STDCPP_DEFAULT_NEW_ALIGNMENT__);
+      auto const rounded = size + (granule - size % granule) % granule;
+      return rounded < size ? size : rounded;
+    }
+  }
+
   typename heap::pointer heap::allocate(size_type size, size_type alignment) noexcept
   {
-    return ::operator new(size, std::align_val_t(alignment), std::nothrow);
+    return ::operator new(round_up(size, alignment), std::align_val_t(alignment), std::nothrow);
+  }
+  allocation_result<heap::pointer, heap::size_type> heap::allocate_at_least(
+    size_type size, size_type alignment) noexcept
+  {
+    auto const rounded = round_up(size, alignment);
+    if (auto ptr = ::operator new(rounded, std::align_val_t(alignment), std::nothrow))
+    {
+      return {ptr, rounded};
+    }
+    return {nullptr, 0};
   }
   void heap::deallocate(pointer ptr, size_type size, size_type alignment) noexcept
   {
-    ::operator delete(ptr, size, std::align_val_t(alignment));
+    ::operator delete(ptr, round_up(size, alignment), std::align_val_t(alignment));
   }
 }
\ No newline at end of file